@@ -0,0 +1,184 @@
+/**
+ * @file Arena_Functions.c
+ * @brief Arena allocator for scratch buffers
+ *
+ * The sort, selection and parse kernels need large temporary buffers for
+ * the length of one call. Taking them from an arena instead of malloc()
+ * means a repeated pipeline reuses the same memory every time: when the
+ * arena is rolled back to empty, blocks it had to chain together are
+ * merged into one block big enough for the whole run.
+ */
+
+#include "Arena_Header.h" // linking the header definitions
+#include <stdlib.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#define ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define ARENA_THREAD_LOCAL _Thread_local
+#endif
+
+#define ROUND_UP(value, align) (((value) + (align) - 1) / (align) * (align)) // next multiple of align
+
+/**
+ * @brief Header at the start of every block, data follows at ARENA_ALIGN
+ */
+struct Arena_Block {
+    Arena_Block* previous; // older block, NULL for the first
+    size_t size; // usable bytes after the header
+    size_t used; // bytes handed out so far
+    void* allocation; // pointer returned by malloc, before alignment
+};
+
+#define BLOCK_HEADER ROUND_UP(sizeof(Arena_Block), ARENA_ALIGN) // bytes reserved for the header
+
+static ARENA_THREAD_LOCAL Arena scratch_arena = { NULL, 0 }; /**< One scratch arena per thread */
+
+ /**
+  * @brief Allocates a block with at least size usable bytes
+  *
+  * @param[in] size Usable bytes wanted
+  * @param[in] previous Block to chain behind the new one
+  * @return Arena_Block* New block, NULL if out of memory
+  */
+static Arena_Block* New_Block(size_t size, Arena_Block* previous) {
+    void* allocation = malloc(BLOCK_HEADER + size + ARENA_ALIGN);
+    Arena_Block* block;
+
+    if (allocation == NULL) {
+        return NULL;
+    }
+    block = (Arena_Block*)ROUND_UP((uintptr_t)allocation, ARENA_ALIGN);
+    block->previous = previous;
+    block->size = size;
+    block->used = 0;
+    block->allocation = allocation;
+    return block;
+}
+
+/**
+ * @brief Prepares an empty arena
+ *
+ * @param[out] arena Arena to initialise
+ * @param[in] minimum_block Smallest block to request, 0 for ARENA_MIN_BLOCK
+ *
+ * @return void
+ */
+void Arena_Init(Arena* arena, size_t minimum_block) {
+    arena->current = NULL;
+    arena->minimum_block = minimum_block;
+}
+
+/**
+ * @brief Allocates bytes from the arena
+ *
+ * @param[in,out] arena Arena to allocate from
+ * @param[in] bytes Number of bytes wanted
+ * @return void* ARENA_ALIGN aligned memory, NULL if out of memory
+ *
+ * @note The memory is released by Arena_Restore() or Arena_Free(), never
+ *       by free()
+ */
+void* Arena_Alloc(Arena* arena, size_t bytes) {
+    Arena_Block* block = arena->current;
+    size_t rounded = ROUND_UP(bytes > 0 ? bytes : 1, ARENA_ALIGN);
+
+    if (block == NULL || block->size - block->used < rounded) {
+        size_t minimum = (arena->minimum_block > 0) ? arena->minimum_block : ARENA_MIN_BLOCK;
+        size_t size = (rounded > minimum) ? rounded : minimum;
+        if (block != NULL && block->size * 2 > size) {
+            size = block->size * 2; /**< Geometric growth keeps the number of blocks small */
+        }
+        block = New_Block(size, block);
+        if (block == NULL) {
+            return NULL;
+        }
+        arena->current = block;
+    }
+    void* memory = (char*)block + BLOCK_HEADER + block->used;
+    block->used += rounded;
+    return memory;
+}
+
+/**
+ * @brief Remembers the current position of the arena
+ *
+ * @param[in] arena Arena to mark
+ * @return Arena_Mark Position to pass to Arena_Restore()
+ */
+Arena_Mark Arena_Save(const Arena* arena) {
+    Arena_Mark mark;
+
+    mark.block = arena->current;
+    mark.used = (arena->current != NULL) ? arena->current->used : 0;
+    return mark;
+}
+
+/**
+ * @brief Releases everything allocated since a mark
+ *
+ * Blocks added after the mark are freed. When the mark is the start of
+ * the arena and more than one block had been chained, they are replaced
+ * by a single block of their combined size, so the next run of the same
+ * shape is served without calling malloc().
+ *
+ * @param[in,out] arena Arena to roll back
+ * @param[in] mark Position returned by Arena_Save() on this arena
+ *
+ * @return void
+ */
+void Arena_Restore(Arena* arena, Arena_Mark mark) {
+    int at_start = (mark.block == NULL) || (mark.block->previous == NULL && mark.used == 0);
+
+    if (at_start && arena->current != NULL) {
+        size_t total = 0;
+        if (arena->current->previous == NULL) {
+            arena->current->used = 0; /**< Single block already, keep it */
+            return;
+        }
+        while (arena->current != NULL) {
+            Arena_Block* block = arena->current;
+            total += block->size;
+            arena->current = block->previous;
+            free(block->allocation);
+        }
+        arena->current = New_Block(total, NULL); /**< Stays NULL if out of memory, the arena just starts empty */
+        return;
+    }
+    while (arena->current != mark.block) {
+        Arena_Block* block = arena->current;
+        arena->current = block->previous;
+        free(block->allocation);
+    }
+    if (arena->current != NULL) {
+        arena->current->used = mark.used;
+    }
+}
+
+/**
+ * @brief Returns every block of the arena to the system
+ *
+ * @param[in,out] arena Arena to empty
+ *
+ * @return void
+ */
+void Arena_Free(Arena* arena) {
+    while (arena->current != NULL) {
+        Arena_Block* block = arena->current;
+        arena->current = block->previous;
+        free(block->allocation);
+    }
+}
+
+/**
+ * @brief Returns the scratch arena of the calling thread
+ *
+ * Kernels take a mark on entry, allocate what they need and restore the
+ * mark before returning, so the arena is empty between calls.
+ *
+ * @return Arena* Arena private to the calling thread
+ */
+Arena* Scratch_Arena(void) {
+    return &scratch_arena;
+}
@@ -0,0 +1,38 @@
+#ifndef ARENA_HEADER_H
+#define ARENA_HEADER_H // include guard
+
+#include <stddef.h>
+
+#define ARENA_ALIGN 64 // every allocation starts on a cache line
+#define ARENA_MIN_BLOCK ((size_t)1 << 20) // smallest block requested from malloc
+
+typedef struct Arena_Block Arena_Block; // one malloc'd block, defined in Arena_Functions.c
+
+/**
+ * @brief Bump allocator for short-lived scratch buffers
+ *
+ * Allocations are carved from large blocks and released together by
+ * rolling back to a mark. Once the arena has grown to the largest size a
+ * run needs, later runs of the same shape never call malloc.
+ */
+typedef struct Arena {
+    Arena_Block* current; // newest block, NULL while the arena is empty
+    size_t minimum_block; // smallest block to allocate, 0 means ARENA_MIN_BLOCK
+} Arena;
+
+/**
+ * @brief Position in an arena to roll back to
+ */
+typedef struct Arena_Mark {
+    Arena_Block* block; // block that was current when the mark was taken
+    size_t used; // bytes used in that block
+} Arena_Mark;
+
+void Arena_Init(Arena* arena, size_t minimum_block); // prepares an empty arena, 0 selects ARENA_MIN_BLOCK
+void* Arena_Alloc(Arena* arena, size_t bytes); // returns ARENA_ALIGN aligned memory, NULL if out of memory
+Arena_Mark Arena_Save(const Arena* arena); // remembers the current position
+void Arena_Restore(Arena* arena, Arena_Mark mark); // releases everything allocated since the mark
+void Arena_Free(Arena* arena); // returns every block to the system
+Arena* Scratch_Arena(void); // per-thread arena used by the sort, selection and parse kernels
+
+#endif // ARENA_HEADER_H
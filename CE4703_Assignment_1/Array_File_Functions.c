@@ -0,0 +1,248 @@
+/**
+ * @file Array_File_Functions.c
+ * @brief Binary array files that are memory-mapped on load
+ *
+ * An array file is a fixed 64-byte header followed by the elements as a
+ * sentinel array. Array_Load() maps the file instead of reading it, so a
+ * dataset is available as soon as the mapping exists and the sort, stats
+ * and print kernels run directly on the mapped pages. The mapping uses
+ * mmap() on POSIX systems and MapViewOfFile() on Windows.
+ */
+
+#include "Array_File_Header.h" // linking the header definitions
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+typedef char Array_File_Header_Size_Check[(sizeof(Array_File_Header) == ARRAY_FILE_HEADER_SIZE) ? 1 : -1]; /**< Fails to compile if the header layout changes size */
+
+ /**
+  * @brief Opens a file for binary writing
+  *
+  * @param[in] path File to create or truncate
+  * @return FILE* Open stream, NULL on failure
+  */
+static FILE* Open_For_Write(const char* path) {
+    FILE* file = NULL;
+#if defined(_MSC_VER)
+    if (fopen_s(&file, path, "wb") != 0) {
+        file = NULL;
+    }
+#else
+    file = fopen(path, "wb");
+#endif
+    return file;
+}
+
+/**
+ * @brief Checks that a mapped file holds a readable array
+ *
+ * @param[in] base Start of the mapping
+ * @param[in] length Bytes mapped
+ * @return int ARRAY_FILE_OK or ARRAY_FILE_BAD_FORMAT
+ */
+static int Validate(const void* base, size_t length) {
+    const Array_File_Header* header = base;
+
+    if (length < ARRAY_FILE_HEADER_SIZE
+        || memcmp(header->magic, ARRAY_FILE_MAGIC, sizeof(header->magic)) != 0
+        || header->version != ARRAY_FILE_VERSION
+        || header->element_type != ARRAY_FILE_TYPE_INT32
+        || header->capacity < 0 || header->capacity > INT_MAX
+        || header->used < 0 || header->used > header->capacity
+        || (uint64_t)header->capacity * sizeof(int) > length - ARRAY_FILE_HEADER_SIZE) {
+        return ARRAY_FILE_BAD_FORMAT;
+    }
+    return ARRAY_FILE_OK;
+}
+
+/**
+ * @brief Writes a sentinel array to a binary array file
+ *
+ * @param[in] path File to create or overwrite
+ * @param[in] array Array to save
+ * @param[in] capacity Total number of elements in array
+ * @param[in] with_stats Non-zero to store precomputed statistics in the header
+ * @return int ARRAY_FILE_OK or ARRAY_FILE_IO_ERROR
+ *
+ * @note Elements are written in host byte order, which the format defines
+ *       as little-endian
+ */
+int Array_Save(const char* path, int array[], int capacity, int with_stats) {
+    Array_File_Header header;
+    Array_Statistics stats;
+    FILE* file;
+    int status = ARRAY_FILE_OK;
+
+    Array_Stats(array, capacity, &stats);
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic));
+    header.version = ARRAY_FILE_VERSION;
+    header.element_type = ARRAY_FILE_TYPE_INT32;
+    header.capacity = capacity;
+    header.used = stats.count;
+    if (with_stats) {
+        header.flags = ARRAY_FILE_HAS_STATS;
+        header.min = stats.min;
+        header.max = stats.max;
+        header.sum = stats.sum;
+        header.variance = stats.variance;
+    }
+
+    file = Open_For_Write(path);
+    if (file == NULL) {
+        return ARRAY_FILE_IO_ERROR;
+    }
+    if (fwrite(&header, sizeof(header), 1, file) != 1
+        || (capacity > 0 && fwrite(array, sizeof(int), (size_t)capacity, file) != (size_t)capacity)) {
+        status = ARRAY_FILE_IO_ERROR;
+    }
+    if (fclose(file) != 0) {
+        status = ARRAY_FILE_IO_ERROR;
+    }
+    return status;
+}
+
+/**
+ * @brief Maps an array file into memory
+ *
+ * The mapping is private: writes through mapping->data (for example from
+ * Sort_Array() or Shuffle_Array()) are visible to this process only and
+ * never reach the file.
+ *
+ * @param[in] path File to map
+ * @param[out] mapping Receives the mapped array
+ * @return int ARRAY_FILE_OK, ARRAY_FILE_IO_ERROR or ARRAY_FILE_BAD_FORMAT
+ *
+ * @code
+ * Array_Mapping mapping;
+ * if (Array_Load("data.arr", &mapping) == ARRAY_FILE_OK) {
+ *     Sort_Array(mapping.data, mapping.capacity);
+ *     Array_Unload(&mapping);
+ * }
+ * @endcode
+ */
+int Array_Load(const char* path, Array_Mapping* mapping) {
+    int status;
+
+    memset(mapping, 0, sizeof(*mapping));
+#if defined(_WIN32)
+    LARGE_INTEGER size;
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return ARRAY_FILE_IO_ERROR;
+    }
+    if (!GetFileSizeEx(file, &size) || (unsigned long long)size.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        return ARRAY_FILE_IO_ERROR;
+    }
+    if (size.QuadPart < ARRAY_FILE_HEADER_SIZE) {
+        CloseHandle(file);
+        return ARRAY_FILE_BAD_FORMAT;
+    }
+    HANDLE map = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    void* base = (map != NULL) ? MapViewOfFile(map, FILE_MAP_COPY, 0, 0, 0) : NULL;
+    if (base == NULL) {
+        if (map != NULL) {
+            CloseHandle(map);
+        }
+        CloseHandle(file);
+        return ARRAY_FILE_IO_ERROR;
+    }
+    mapping->file_handle = file;
+    mapping->map_handle = map;
+    mapping->length = (size_t)size.QuadPart;
+#else
+    struct stat info;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return ARRAY_FILE_IO_ERROR;
+    }
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return ARRAY_FILE_IO_ERROR;
+    }
+    if (info.st_size < ARRAY_FILE_HEADER_SIZE) {
+        close(fd);
+        return ARRAY_FILE_BAD_FORMAT;
+    }
+    void* base = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); /**< The mapping keeps the file referenced */
+    if (base == MAP_FAILED) {
+        return ARRAY_FILE_IO_ERROR;
+    }
+    mapping->length = (size_t)info.st_size;
+#endif
+    mapping->base = base;
+
+    status = Validate(base, mapping->length);
+    if (status != ARRAY_FILE_OK) {
+        Array_Unload(mapping);
+        return status;
+    }
+    mapping->header = base;
+    mapping->data = (int*)((char*)base + ARRAY_FILE_HEADER_SIZE);
+    mapping->capacity = (int)mapping->header->capacity;
+    mapping->used = (int)mapping->header->used;
+    return ARRAY_FILE_OK;
+}
+
+/**
+ * @brief Releases a mapping made by Array_Load()
+ *
+ * @param[in,out] mapping Mapping to release, left empty
+ *
+ * @return void
+ */
+void Array_Unload(Array_Mapping* mapping) {
+    if (mapping->base != NULL) {
+#if defined(_WIN32)
+        UnmapViewOfFile(mapping->base);
+        CloseHandle((HANDLE)mapping->map_handle);
+        CloseHandle((HANDLE)mapping->file_handle);
+#else
+        munmap(mapping->base, mapping->length);
+#endif
+    }
+    memset(mapping, 0, sizeof(*mapping));
+}
+
+/**
+ * @brief Returns the statistics of a mapped array
+ *
+ * If the file was saved with precomputed statistics they are read from
+ * the header without touching the elements; otherwise they are computed
+ * with Array_Stats().
+ *
+ * @param[in] mapping Mapped array
+ * @param[out] stats Structure receiving the statistics
+ *
+ * @return void
+ *
+ * @warning Header statistics describe the file as saved, so they are only
+ *          valid while the mapped values have not been changed
+ */
+void Array_File_Stats(const Array_Mapping* mapping, Array_Statistics* stats) {
+    const Array_File_Header* header = mapping->header;
+
+    if (!(header->flags & ARRAY_FILE_HAS_STATS)) {
+        Array_Stats(mapping->data, mapping->capacity, stats);
+        return;
+    }
+    stats->count = mapping->used;
+    stats->sum = header->sum;
+    stats->min = header->min;
+    stats->max = header->max;
+    stats->mean = (mapping->used > 0) ? (double)header->sum / mapping->used : 0.0;
+    stats->variance = header->variance;
+    stats->standard_deviation = sqrt(header->variance);
+}
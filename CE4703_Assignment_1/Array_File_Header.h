@@ -0,0 +1,61 @@
+#ifndef ARRAY_FILE_HEADER_H
+#define ARRAY_FILE_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+#include "Maths_Operations_Header.h" // include maths header for Array_Statistics
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARRAY_FILE_MAGIC "CE4703AR" // first 8 bytes of every array file
+#define ARRAY_FILE_VERSION 1 // current format version
+#define ARRAY_FILE_TYPE_INT32 1 // elements are 32-bit little-endian ints
+#define ARRAY_FILE_HAS_STATS 0x1u // header flag: the stats fields are filled in
+#define ARRAY_FILE_HEADER_SIZE 64 // element data starts at this byte offset
+
+#define ARRAY_FILE_OK 0 // success
+#define ARRAY_FILE_IO_ERROR -1 // file could not be opened, sized, mapped or written
+#define ARRAY_FILE_BAD_FORMAT -2 // file is not an array file this version can read
+
+/**
+ * @brief On-disk header of an array file, followed by capacity ints
+ *
+ * Elements are stored as a sentinel array, exactly as they are held in
+ * memory, so a mapped file can be handed to every kernel unchanged.
+ */
+typedef struct Array_File_Header {
+    char magic[8]; // ARRAY_FILE_MAGIC, not null terminated
+    uint32_t version; // ARRAY_FILE_VERSION
+    uint32_t element_type; // ARRAY_FILE_TYPE_INT32
+    int64_t capacity; // total number of elements stored
+    int64_t used; // number of used elements
+    uint32_t flags; // ARRAY_FILE_HAS_STATS when the fields below are valid
+    int32_t min; // smallest used element
+    int32_t max; // largest used element
+    uint32_t reserved; // zero
+    int64_t sum; // exact sum of used elements
+    double variance; // population variance of used elements
+} Array_File_Header;
+
+/**
+ * @brief An array file mapped into memory
+ *
+ * The mapping is private (copy-on-write), so the kernels may sort or
+ * shuffle data in place without changing the file on disk.
+ */
+typedef struct Array_Mapping {
+    int* data; // first element, inside the mapping
+    int capacity; // number of elements
+    int used; // number of used elements recorded in the header
+    const Array_File_Header* header; // header at the start of the mapping
+    void* base; // start of the mapping
+    size_t length; // bytes mapped
+    void* file_handle; // Windows file handle, unused elsewhere
+    void* map_handle; // Windows mapping handle, unused elsewhere
+} Array_Mapping;
+
+int Array_Save(const char* path, int array[], int capacity, int with_stats); // writes a sentinel array to a file, returns an ARRAY_FILE_ code
+int Array_Load(const char* path, Array_Mapping* mapping); // maps an array file, returns an ARRAY_FILE_ code
+void Array_Unload(Array_Mapping* mapping); // releases a mapping made by Array_Load()
+void Array_File_Stats(const Array_Mapping* mapping, Array_Statistics* stats); // statistics from the header if stored, otherwise computed
+
+#endif // ARRAY_FILE_HEADER_H
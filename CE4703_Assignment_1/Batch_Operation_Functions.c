@@ -0,0 +1,198 @@
+/**
+ * @file Batch_Operation_Functions.c
+ * @brief Summary statistics of many small arrays in one call
+ *
+ * Calling Array_Stats() once per array spends most of its time on call
+ * overhead and loops too short to vectorize. Batch_Stats() instead takes
+ * SIMD_BATCH_LANES arrays at a time and scans them side by side, one array
+ * per vector lane, then writes the results straight into column arrays.
+ *
+ * The arrays may be stored one after another (array_stride = capacity,
+ * element_stride = 1), interleaved so that element j of every array is
+ * contiguous (array_stride = 1, element_stride = arrays), or with any
+ * other strides. Interleaved arrays are scanned in place; other layouts
+ * are gathered into lanes BATCH_BLOCK elements at a time.
+ */
+
+#include "Batch_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include "Maths_Operations_Header.h" // linking PARALLEL_STATS_THRESHOLD
+#include "Simd_Operations_Header.h" // linking the batched scan kernel
+#include "Parallel_Header.h" // linking the worker pool for large batches
+#include <limits.h>
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief Layout and destination of one Batch_Stats() call
+ */
+typedef struct Batch_Job {
+    const int* data; // first element of the first array
+    int arrays; // number of arrays
+    int capacity; // elements per array
+    int array_stride; // distance in ints between consecutive arrays
+    int element_stride; // distance in ints between consecutive elements of an array
+    const Batch_Columns* columns; // where the results go
+    int tiles_per_task; // groups of SIMD_BATCH_LANES arrays per parallel task
+} Batch_Job;
+
+/**
+ * @brief Returns element j of array i
+ */
+static int Batch_Value(const Batch_Job* job, int i, int j) {
+    return job->data[(ptrdiff_t)i * job->array_stride + (ptrdiff_t)j * job->element_stride];
+}
+
+/**
+ * @brief Computes the statistics of up to SIMD_BATCH_LANES consecutive arrays
+ *
+ * Each lane's shift is its array's first used element, as in Array_Stats(),
+ * so the variance keeps its precision. Lanes past the last array are fed
+ * UNUSED_MARKER and their results are dropped.
+ *
+ * @param[in] job Layout and output columns
+ * @param[in] first Index of the array in lane 0
+ */
+static void Batch_Tile(const Batch_Job* job, int first) {
+    int lanes_used = job->arrays - first; /**< Real arrays in this tile */
+    Lane_Moments lanes;
+    int block[BATCH_BLOCK * SIMD_BATCH_LANES]; /**< Gathered rows for non-interleaved layouts */
+
+    if (lanes_used > SIMD_BATCH_LANES) {
+        lanes_used = SIMD_BATCH_LANES;
+    }
+    for (int lane = 0; lane < SIMD_BATCH_LANES; lane++) {
+        lanes.count[lane] = 0;
+        lanes.sum[lane] = 0;
+        lanes.min[lane] = INT_MAX;
+        lanes.max[lane] = INT_MIN;
+        lanes.shift[lane] = 0;
+        lanes.sum_squares[lane] = 0.0;
+        for (int j = 0; lane < lanes_used && j < job->capacity; j++) {
+            int value = Batch_Value(job, first + lane, j);
+            if (IS_USED(value)) {
+                lanes.shift[lane] = value;
+                break;
+            }
+        }
+    }
+
+    if (lanes_used == SIMD_BATCH_LANES && job->array_stride == 1) {
+        /* Interleaved: row j of the tile is already contiguous */
+        Moments_Scan_Lanes(job->data + first, job->capacity, job->element_stride, &lanes);
+    }
+    else {
+        for (int start = 0; start < job->capacity; start += BATCH_BLOCK) {
+            int rows = job->capacity - start;
+            if (rows > BATCH_BLOCK) {
+                rows = BATCH_BLOCK;
+            }
+            for (int lane = 0; lane < SIMD_BATCH_LANES; lane++) {
+                for (int r = 0; r < rows; r++) {
+                    block[r * SIMD_BATCH_LANES + lane] = (lane < lanes_used) ? Batch_Value(job, first + lane, start + r) : UNUSED_MARKER;
+                }
+            }
+            Moments_Scan_Lanes(block, rows, SIMD_BATCH_LANES, &lanes);
+        }
+    }
+
+    /* Same formulas as Stats_From_Moments(), written straight to the columns */
+    const Batch_Columns* columns = job->columns;
+    for (int lane = 0; lane < lanes_used; lane++) {
+        int index = first + lane;
+        int count = lanes.count[lane];
+        double mean = 0.0;
+        double variance = 0.0;
+
+        if (count > 0) {
+            double shifted_sum = (double)(lanes.sum[lane] - (long long)count * lanes.shift[lane]); /**< Sum of deviations from the shift */
+            variance = (lanes.sum_squares[lane] - shifted_sum * shifted_sum / count) / count;
+            if (variance < 0.0) {
+                variance = 0.0; /**< Guard against rounding just below zero */
+            }
+            mean = (double)lanes.sum[lane] / count;
+        }
+        if (columns->count != NULL) {
+            columns->count[index] = count;
+        }
+        if (columns->sum != NULL) {
+            columns->sum[index] = lanes.sum[lane];
+        }
+        if (columns->min != NULL) {
+            columns->min[index] = (count > 0) ? lanes.min[lane] : UNUSED_MARKER;
+        }
+        if (columns->max != NULL) {
+            columns->max[index] = (count > 0) ? lanes.max[lane] : UNUSED_MARKER;
+        }
+        if (columns->mean != NULL) {
+            columns->mean[index] = mean;
+        }
+        if (columns->variance != NULL) {
+            columns->variance[index] = variance;
+        }
+        if (columns->standard_deviation != NULL) {
+            columns->standard_deviation[index] = sqrt(variance);
+        }
+    }
+}
+
+/**
+ * @brief Parallel task: computes a contiguous run of tiles
+ */
+static void Batch_Task(void* context, int task) {
+    const Batch_Job* job = context;
+    int first = task * job->tiles_per_task * SIMD_BATCH_LANES;
+    int end = first + job->tiles_per_task * SIMD_BATCH_LANES;
+
+    if (end > job->arrays) {
+        end = job->arrays;
+    }
+    for (int i = first; i < end; i += SIMD_BATCH_LANES) {
+        Batch_Tile(job, i);
+    }
+}
+
+/**
+ * @brief Computes the summary statistics of the used elements of many arrays
+ *
+ * Gives, for every array, the values Array_Stats() would give, but scans
+ * SIMD_BATCH_LANES arrays at once with one array per vector lane, so short
+ * arrays still use the full vector width. Batches of PARALLEL_STATS_THRESHOLD
+ * elements or more are split across the worker pool.
+ *
+ * @param[in] data First element of the first array
+ * @param[in] arrays Number of arrays
+ * @param[in] capacity Number of elements in each array
+ * @param[in] array_stride Distance in ints between element 0 of consecutive arrays
+ * @param[in] element_stride Distance in ints between consecutive elements of one array
+ * @param[out] columns Output columns of at least arrays entries, NULL columns are skipped
+ * @return int 0 on success, -1 if an argument is invalid
+ *
+ * @see Array_Stats()
+ */
+int Batch_Stats(const int data[], int arrays, int capacity, int array_stride, int element_stride, const Batch_Columns* columns) {
+    if (columns == NULL || arrays < 0 || capacity < 0 || (data == NULL && arrays > 0 && capacity > 0)) {
+        return -1;
+    }
+
+    int tiles = (arrays + SIMD_BATCH_LANES - 1) / SIMD_BATCH_LANES;
+    Batch_Job job = { data, arrays, capacity, array_stride, element_stride, columns, tiles };
+
+    if ((long long)arrays * capacity < PARALLEL_STATS_THRESHOLD) {
+        Batch_Task(&job, 0);
+        return 0;
+    }
+
+    int threads = Parallel_Thread_Count();
+    if (threads <= 1) {
+        Batch_Task(&job, 0);
+        return 0;
+    }
+
+    int tasks = threads * REDUCE_TASKS_PER_THREAD; /**< A few tasks per thread to even out the load */
+    job.tiles_per_task = (tiles + tasks - 1) / tasks;
+    tasks = (tiles + job.tiles_per_task - 1) / job.tiles_per_task;
+    Simd_Level(); /**< Resolve the lanes kernel here, not on several workers at once */
+    Parallel_Run(tasks, Batch_Task, &job);
+    return 0;
+}
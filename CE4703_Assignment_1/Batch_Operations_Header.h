@@ -0,0 +1,27 @@
+#ifndef BATCH_OPERATIONS_HEADER_H
+#define BATCH_OPERATIONS_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+
+#define BATCH_BLOCK 64 // elements per array gathered into lanes at a time when the arrays are not interleaved
+
+/**
+ * @brief Output columns of Batch_Stats()
+ *
+ * Entry i of each column receives the statistic of array i, with the same
+ * meaning as the matching field of Array_Statistics. A column left NULL is
+ * not written.
+ */
+typedef struct Batch_Columns {
+    int* count; // number of used elements
+    long long* sum; // exact sum of used elements
+    int* min; // smallest used element, UNUSED_MARKER if none
+    int* max; // largest used element, UNUSED_MARKER if none
+    double* mean; // arithmetic mean, 0 if no used elements
+    double* variance; // population variance, 0 if no used elements
+    double* standard_deviation; // square root of the variance
+} Batch_Columns;
+
+int Batch_Stats(const int data[], int arrays, int capacity, int array_stride, int element_stride, const Batch_Columns* columns); // statistics of the used elements of many arrays in one call, element j of array i is data[i * array_stride + j * element_stride], returns 0 or -1 on bad arguments
+
+#endif // BATCH_OPERATIONS_HEADER_H
@@ -0,0 +1,333 @@
+/**
+ * @file Benchmark.c
+ * @brief Benchmark harness timing every working function across sizes
+ *
+ * Built as a separate executable (CE4703_Benchmark.vcxproj) from the same
+ * sources as the main program, minus Main.c and Menu_Functions.c. Each
+ * function is timed on arrays from 10 elements up to a maximum size and
+ * at several fill ratios. Every measurement is preceded by a warm-up run
+ * and the median of the repetitions is reported as CSV on stdout:
+ *
+ * function,size,fill_percent,used,threads,repetitions,median_ns,ns_per_element,gb_per_s
+ *
+ * Usage: Benchmark [max_size] [repetitions]
+ */
+
+#define _POSIX_C_SOURCE 199309L // clock_gettime() and CLOCK_MONOTONIC under -std=c11
+
+#include "Main_Header.h"
+#include "Simple_Operations_Header.h"
+#include "Maths_Operations_Header.h"
+#include "Matrice_Operations_Header.h"
+#include "Int_Array_Header.h"
+#include "Parallel_Header.h"
+#include "Random_Engine_Header.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#define NULL_DEVICE "NUL"
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#define open _open
+#define O_WRONLY _O_WRONLY
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define BENCH_DEFAULT_MAX_SIZE 100000000 // largest array size swept by default (1e8)
+#define BENCH_DEFAULT_REPETITIONS 5 // timed runs per measurement
+#define BENCH_MAX_REPETITIONS 101 // upper bound on repetitions
+#define BENCH_VALUE_MIN 0 // smallest random value stored
+#define BENCH_VALUE_MAX 1000000 // largest random value stored
+
+static const int fill_percents[] = { 0, 25, 50, 75, 100 }; /**< Share of slots that hold a value */
+
+/**
+ * @brief Array and bookkeeping shared by every benchmark of one size and fill
+ */
+typedef struct Bench_Context {
+    int* array; // array under test
+    int* pristine; // copy restored before each run of a mutating benchmark
+    int capacity; // total number of slots
+    int used; // number of used slots
+    long long sink; // results are folded in here so the calls are not optimised away
+    int saved_stdout; // descriptor of the real stdout while it is redirected, -1 otherwise
+} Bench_Context;
+
+typedef void (*Bench_Function)(Bench_Context* context); // one timed call
+
+/**
+ * @brief One row of the benchmark table
+ */
+typedef struct Bench_Entry {
+    const char* name; // function name written to the CSV
+    Bench_Function run; // timed call
+    int mutates; // non-zero if the array must be restored before each run
+    Bench_Function setup; // untimed call before the warm-up, or NULL
+    Bench_Function teardown; // untimed call after the last run, or NULL
+} Bench_Entry;
+
+ /**
+  * @brief Returns a monotonic time stamp in nanoseconds
+  *
+  * @return double Nanoseconds since an arbitrary fixed point
+  */
+static double Now_Ns(void) {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+#endif
+}
+
+static void Bench_Random_int(Bench_Context* c) {
+    for (int i = 0; i < c->capacity; i++) {
+        c->sink += Random_int(BENCH_VALUE_MIN, BENCH_VALUE_MAX);
+    }
+}
+
+static void Bench_Array_Random(Bench_Context* c) {
+    Array_Random(c->array, c->used, c->capacity, BENCH_VALUE_MIN, BENCH_VALUE_MAX);
+}
+
+static void Bench_Clear_Array(Bench_Context* c) {
+    Clear_Array(c->array, c->capacity);
+}
+
+static void Bench_Sort_Array(Bench_Context* c) {
+    Sort_Array(c->array, c->capacity);
+}
+
+static void Bench_Shuffle_Array(Bench_Context* c) {
+    Shuffle_Array(c->array, c->capacity);
+}
+
+static void Bench_Find_Min(Bench_Context* c) {
+    c->sink += Find_Min(c->array, c->capacity);
+}
+
+static void Bench_Find_Max(Bench_Context* c) {
+    c->sink += Find_Max(c->array, c->capacity);
+}
+
+static void Bench_Mean_Average(Bench_Context* c) {
+    c->sink += (long long)Mean_Average(c->array, c->capacity);
+}
+
+static void Bench_Median_Average(Bench_Context* c) {
+    c->sink += Median_Average(c->array, c->capacity);
+}
+
+static void Bench_Variance(Bench_Context* c) {
+    c->sink += (long long)Variance(c->array, c->capacity);
+}
+
+static void Bench_Standard_Deviation(Bench_Context* c) {
+    c->sink += (long long)Standard_Deviation(c->array, c->capacity);
+}
+
+static void Bench_Num_of_Used_Elements(Bench_Context* c) {
+    c->sink += Num_of_Used_Elements(c->array, c->capacity);
+}
+
+static void Bench_Print_All(Bench_Context* c) {
+    Print_All(c->array, c->capacity);
+}
+
+/**
+ * @brief Sends standard output to the null device for the Print_All() runs
+ *
+ * The CSV is written to the same stdout, so it is flushed first. The
+ * redirection is done once here rather than in the timed call, so the
+ * rows measure Print_All() and not the system calls.
+ */
+static void Bench_Redirect_Stdout(Bench_Context* c) {
+    int null_device = open(NULL_DEVICE, O_WRONLY);
+
+    fflush(stdout);
+    c->saved_stdout = -1;
+    if (null_device < 0) {
+        return;
+    }
+    c->saved_stdout = dup(1);
+    if (c->saved_stdout >= 0) {
+        dup2(null_device, 1);
+    }
+    close(null_device);
+}
+
+/**
+ * @brief Flushes what Print_All() left buffered and restores standard output
+ */
+static void Bench_Restore_Stdout(Bench_Context* c) {
+    fflush(stdout);
+    if (c->saved_stdout >= 0) {
+        dup2(c->saved_stdout, 1);
+        close(c->saved_stdout);
+        c->saved_stdout = -1;
+    }
+}
+
+static const Bench_Entry entries[] = {
+    { "Random_int", Bench_Random_int, 0, NULL, NULL },
+    { "Array_Random", Bench_Array_Random, 1, NULL, NULL },
+    { "Clear_Array", Bench_Clear_Array, 1, NULL, NULL },
+    { "Sort_Array", Bench_Sort_Array, 1, NULL, NULL },
+    { "Shuffle_Array", Bench_Shuffle_Array, 1, NULL, NULL },
+    { "Find_Min", Bench_Find_Min, 0, NULL, NULL },
+    { "Find_Max", Bench_Find_Max, 0, NULL, NULL },
+    { "Mean_Average", Bench_Mean_Average, 0, NULL, NULL },
+    { "Median_Average", Bench_Median_Average, 0, NULL, NULL },
+    { "Variance", Bench_Variance, 0, NULL, NULL },
+    { "Standard_Deviation", Bench_Standard_Deviation, 0, NULL, NULL },
+    { "Num_of_Used_Elements", Bench_Num_of_Used_Elements, 0, NULL, NULL },
+    { "Print_All", Bench_Print_All, 0, Bench_Redirect_Stdout, Bench_Restore_Stdout },
+}; /**< Every benchmarked function, in CSV order */
+
+/**
+ * @brief Orders doubles ascending for qsort()
+ */
+static int Compare_Doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Times one benchmark and returns the median run time
+ *
+ * One untimed warm-up run brings the code and data into cache. A
+ * mutating benchmark has the array restored from the pristine copy
+ * before every run, and the setup and teardown hooks run once around
+ * all the runs, all outside the timed region.
+ *
+ * @param[in] entry Benchmark to run
+ * @param[in,out] context Array under test
+ * @param[in] repetitions Number of timed runs
+ * @return double Median run time in nanoseconds
+ */
+static double Time_Entry(const Bench_Entry* entry, Bench_Context* context, int repetitions) {
+    double samples[BENCH_MAX_REPETITIONS];
+
+    if (entry->setup != NULL) {
+        entry->setup(context);
+    }
+    for (int r = -1; r < repetitions; r++) {
+        if (entry->mutates) {
+            memcpy(context->array, context->pristine, (size_t)context->capacity * sizeof(int));
+        }
+        double start = Now_Ns();
+        entry->run(context);
+        double elapsed = Now_Ns() - start;
+        if (r >= 0) {
+            samples[r] = elapsed; /**< r = -1 is the warm-up */
+        }
+    }
+    if (entry->teardown != NULL) {
+        entry->teardown(context);
+    }
+    if (entry->mutates) {
+        memcpy(context->array, context->pristine, (size_t)context->capacity * sizeof(int));
+    }
+    qsort(samples, (size_t)repetitions, sizeof(double), Compare_Doubles);
+    if (repetitions % 2 != 0) {
+        return samples[repetitions / 2];
+    }
+    return (samples[repetitions / 2 - 1] + samples[repetitions / 2]) / 2.0;
+}
+
+/**
+ * @brief Runs every benchmark on one size and fill ratio and prints the rows
+ *
+ * The used values are scattered over the array by a shuffle, so used and
+ * unused slots are interleaved rather than split into a prefix and a tail.
+ *
+ * @param[in] capacity Array size
+ * @param[in] fill_percent Share of used slots, 0 to 100
+ * @param[in] repetitions Number of timed runs per benchmark
+ * @return int 0 on success, -1 if the arrays could not be allocated
+ */
+static int Run_Size(int capacity, int fill_percent, int repetitions) {
+    IntArray array;
+    IntArray pristine;
+    Bench_Context context;
+
+    if (Int_Array_Init(&array, capacity) != 0) {
+        return -1;
+    }
+    if (Int_Array_Init(&pristine, capacity) != 0) {
+        Int_Array_Free(&array);
+        return -1;
+    }
+    context.array = array.data;
+    context.pristine = pristine.data;
+    context.capacity = capacity;
+    context.used = (int)((long long)capacity * fill_percent / 100);
+    context.sink = 0;
+    context.saved_stdout = -1;
+
+    Array_Random(context.pristine, context.used, capacity, BENCH_VALUE_MIN, BENCH_VALUE_MAX);
+    Shuffle_Array(context.pristine, capacity);
+    memcpy(context.array, context.pristine, (size_t)capacity * sizeof(int));
+
+    for (size_t e = 0; e < sizeof(entries) / sizeof(entries[0]); e++) {
+        double median = Time_Entry(&entries[e], &context, repetitions);
+        double bytes = (double)capacity * sizeof(int);
+        printf("%s,%d,%d,%d,%d,%d,%.0f,%.3f,%.3f\n", entries[e].name, capacity, fill_percent, context.used,
+            Parallel_Thread_Count(), repetitions, median, median / capacity, (median > 0) ? bytes / median : 0.0);
+        fflush(stdout);
+    }
+    if (context.sink == 42) {
+        fprintf(stderr, " "); /**< Keeps the sink live */
+    }
+    Int_Array_Free(&pristine);
+    Int_Array_Free(&array);
+    return 0;
+}
+
+/**
+ * @brief Sweeps sizes 10, 100, ... up to max_size over every fill ratio
+ *
+ * @param[in] argc Argument count
+ * @param[in] argv argv[1] maximum size (default 1e8), argv[2] repetitions (default 5)
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if an array could not be allocated
+ */
+int main(int argc, char* argv[]) {
+    long long max_size = (argc > 1) ? atoll(argv[1]) : BENCH_DEFAULT_MAX_SIZE;
+    int repetitions = (argc > 2) ? atoi(argv[2]) : BENCH_DEFAULT_REPETITIONS;
+
+    if (max_size < 10 || max_size > 0x7fffffff) {
+        max_size = BENCH_DEFAULT_MAX_SIZE;
+    }
+    if (repetitions < 1 || repetitions > BENCH_MAX_REPETITIONS) {
+        repetitions = BENCH_DEFAULT_REPETITIONS;
+    }
+
+    Random_Seed(1); /**< Same data on every run so results are comparable */
+    printf("function,size,fill_percent,used,threads,repetitions,median_ns,ns_per_element,gb_per_s\n");
+    for (long long size = 10; size <= max_size; size *= 10) {
+        for (size_t f = 0; f < sizeof(fill_percents) / sizeof(fill_percents[0]); f++) {
+            if (Run_Size((int)size, fill_percents[f], repetitions) != 0) {
+                fprintf(stderr, "Not enough memory for %lld elements\n", size);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
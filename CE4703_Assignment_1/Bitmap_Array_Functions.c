@@ -0,0 +1,277 @@
+/**
+ * @file Bitmap_Array_Functions.c
+ * @brief Implementation of the validity-bitmap array representation
+ *
+ * Instead of marking unused slots with UNUSED_MARKER, a BitmapArray keeps
+ * one validity bit per slot (in the style of Apache Arrow). This allows
+ * negative values to be stored, and lets the kernels count with popcount
+ * and skip 64 empty slots at a time by testing a single word.
+ */
+
+#include "Bitmap_Array_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define FULL_WORD (~(uint64_t)0) // validity word with all 64 slots used
+
+ /**
+  * @brief Counts the set bits of a validity word
+  *
+  * @param[in] word Validity word
+  * @return int Number of used slots in the word
+  *
+  * @note MSVC uses a portable bit-twiddling count, because its __popcnt64
+  *       intrinsic faults on CPUs without the POPCNT instruction
+  */
+static int Popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((word * 0x0101010101010101ULL) >> 56);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero word
+ *
+ * @param[in] word Validity word, must not be 0
+ * @return int Bit index from 0 to 63
+ */
+static int Lowest_Bit(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)word)) {
+        return (int)index;
+    }
+    _BitScanForward(&index, (unsigned long)(word >> 32));
+    return (int)index + 32;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * @brief Allocates an empty bitmap array
+ *
+ * @param[out] bitmap Array to initialise
+ * @param[in] capacity Number of slots
+ * @return int 0 on success, -1 if memory could not be allocated
+ */
+int Bitmap_Array_Init(BitmapArray* bitmap, int capacity) {
+    size_t words = (size_t)BITMAP_WORDS(capacity); /**< Validity words needed */
+
+    bitmap->capacity = capacity;
+    bitmap->data = malloc((size_t)(capacity > 0 ? capacity : 1) * sizeof(int));
+    bitmap->validity = calloc(words > 0 ? words : 1, sizeof(uint64_t));
+    if (bitmap->data == NULL || bitmap->validity == NULL) {
+        Bitmap_Array_Free(bitmap);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Releases the buffers of a bitmap array
+ *
+ * @param[in,out] bitmap Array to release; its pointers are reset to NULL
+ */
+void Bitmap_Array_Free(BitmapArray* bitmap) {
+    free(bitmap->data);
+    free(bitmap->validity);
+    bitmap->data = NULL;
+    bitmap->validity = NULL;
+    bitmap->capacity = 0;
+}
+
+/**
+ * @brief Marks every slot unused
+ *
+ * Only the bitmap is cleared; the values are left in place.
+ *
+ * @param[in,out] bitmap Array to clear
+ */
+void Bitmap_Array_Clear(BitmapArray* bitmap) {
+    memset(bitmap->validity, 0, (size_t)BITMAP_WORDS(bitmap->capacity) * sizeof(uint64_t));
+}
+
+/**
+ * @brief Stores a value and marks its slot used
+ *
+ * @param[in,out] bitmap Array to modify
+ * @param[in] index Slot index, 0 <= index < capacity
+ * @param[in] value Any int, including negative values
+ */
+void Bitmap_Array_Set(BitmapArray* bitmap, int index, int value) {
+    bitmap->data[index] = value;
+    bitmap->validity[index / BITMAP_WORD_BITS] |= (uint64_t)1 << (index % BITMAP_WORD_BITS);
+}
+
+/**
+ * @brief Marks a slot unused
+ *
+ * @param[in,out] bitmap Array to modify
+ * @param[in] index Slot index, 0 <= index < capacity
+ */
+void Bitmap_Array_Unset(BitmapArray* bitmap, int index) {
+    bitmap->validity[index / BITMAP_WORD_BITS] &= ~((uint64_t)1 << (index % BITMAP_WORD_BITS));
+}
+
+/**
+ * @brief Tests whether a slot is used
+ *
+ * @param[in] bitmap Array to query
+ * @param[in] index Slot index, 0 <= index < capacity
+ * @return int 1 if the slot holds a value, 0 otherwise
+ */
+int Bitmap_Array_Is_Used(const BitmapArray* bitmap, int index) {
+    return (int)((bitmap->validity[index / BITMAP_WORD_BITS] >> (index % BITMAP_WORD_BITS)) & 1);
+}
+
+/**
+ * @brief Builds a bitmap array from a sentinel array
+ *
+ * Allocates the bitmap array and copies every value; a slot is marked
+ * used when its value passes IS_USED.
+ *
+ * @param[out] bitmap Array to initialise
+ * @param[in] array Sentinel array to convert
+ * @param[in] capacity Total number of elements in array
+ * @return int 0 on success, -1 if memory could not be allocated
+ */
+int Bitmap_Array_From_Sentinel(BitmapArray* bitmap, const int array[], int capacity) {
+    if (Bitmap_Array_Init(bitmap, capacity) != 0) {
+        return -1;
+    }
+    memcpy(bitmap->data, array, (size_t)capacity * sizeof(int));
+    for (int base = 0; base < capacity; base += BITMAP_WORD_BITS) {
+        int end = (base + BITMAP_WORD_BITS < capacity) ? base + BITMAP_WORD_BITS : capacity;
+        uint64_t word = 0;
+        for (int i = base; i < end; i++) {
+            word |= (uint64_t)(IS_USED(array[i]) ? 1 : 0) << (i - base); /**< Branch-free bit build */
+        }
+        bitmap->validity[base / BITMAP_WORD_BITS] = word;
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes a bitmap array out as a sentinel array
+ *
+ * Unused slots become UNUSED_MARKER. Used negative values cannot be told
+ * apart from unused slots in the sentinel layout, so they are also written
+ * as UNUSED_MARKER and counted in the return value.
+ *
+ * @param[in] bitmap Array to convert
+ * @param[out] array Sentinel array of at least bitmap->capacity elements
+ * @return int Number of used negative values that were dropped
+ */
+int Bitmap_Array_To_Sentinel(const BitmapArray* bitmap, int array[]) {
+    int dropped = 0;
+
+    for (int i = 0; i < bitmap->capacity; i++) {
+        int value = bitmap->data[i];
+        if (!Bitmap_Array_Is_Used(bitmap, i)) {
+            array[i] = UNUSED_MARKER;
+        }
+        else if (!IS_USED(value)) {
+            array[i] = UNUSED_MARKER;
+            dropped++;
+        }
+        else {
+            array[i] = value;
+        }
+    }
+    return dropped;
+}
+
+/**
+ * @brief Counts the used slots with one popcount per 64 slots
+ *
+ * @param[in] bitmap Array to query
+ * @return int Number of used slots
+ */
+int Bitmap_Array_Count(const BitmapArray* bitmap) {
+    int words = BITMAP_WORDS(bitmap->capacity);
+    int count = 0;
+
+    for (int w = 0; w < words; w++) {
+        count += Popcount64(bitmap->validity[w]);
+    }
+    return count;
+}
+
+/**
+ * @brief Computes every summary statistic of the used slots in one pass
+ *
+ * Walks the bitmap a word at a time. Empty words are skipped in a single
+ * test, full words are accumulated with a branch-free dense loop, and
+ * partially used words visit only their set bits.
+ *
+ * @param[in] bitmap Array to analyse
+ * @param[out] stats Structure receiving the statistics
+ *
+ * @return void
+ *
+ * @note Negative values are included; min and max are UNUSED_MARKER only
+ *       when count is 0
+ */
+void Bitmap_Array_Stats(const BitmapArray* bitmap, Array_Statistics* stats) {
+    Array_Moments moments = { 0, 0, INT_MAX, INT_MIN, 0, 0.0 }; /**< Raw sums of the used slots */
+    int words = BITMAP_WORDS(bitmap->capacity);
+    int shift_found = 0;
+
+    for (int w = 0; w < words; w++) {
+        uint64_t word = bitmap->validity[w];
+        const int* values = bitmap->data + (size_t)w * BITMAP_WORD_BITS;
+
+        if (word == 0) {
+            continue; /**< 64 unused slots skipped at once */
+        }
+        if (!shift_found) {
+            moments.shift = values[Lowest_Bit(word)]; /**< First used value is the shift */
+            shift_found = 1;
+        }
+
+        if (word == FULL_WORD) {
+            for (int i = 0; i < BITMAP_WORD_BITS; i++) {
+                int value = values[i];
+                double deviation = (double)value - moments.shift; /**< Values may be negative, so subtract in double */
+                moments.sum += value;
+                moments.min = (value < moments.min) ? value : moments.min;
+                moments.max = (value > moments.max) ? value : moments.max;
+                moments.sum_squares += deviation * deviation;
+            }
+            moments.count += BITMAP_WORD_BITS;
+            continue;
+        }
+
+        while (word != 0) {
+            int value = values[Lowest_Bit(word)];
+            double deviation = (double)value - moments.shift;
+            moments.count++;
+            moments.sum += value;
+            if (value < moments.min) {
+                moments.min = value;
+            }
+            if (value > moments.max) {
+                moments.max = value;
+            }
+            moments.sum_squares += deviation * deviation;
+            word &= word - 1; /**< Clear the lowest set bit */
+        }
+    }
+
+    Stats_From_Moments(&moments, stats);
+}
@@ -0,0 +1,35 @@
+#ifndef BITMAP_ARRAY_HEADER_H
+#define BITMAP_ARRAY_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+#include "Maths_Operations_Header.h" // include maths header for Array_Statistics
+#include <stdint.h>
+
+#define BITMAP_WORD_BITS 64 // slots covered by one validity word
+#define BITMAP_WORDS(capacity) (((capacity) + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS) // validity words needed for capacity slots
+
+/**
+ * @brief Array whose used slots are tracked by a validity bitmap
+ *
+ * Bit (i % 64) of validity[i / 64] is set when slot i holds a value.
+ * Because usage is not encoded in the value itself, any int, including
+ * negative numbers, can be stored. Bits past capacity are always 0.
+ */
+typedef struct BitmapArray {
+    int* data; // element values, only meaningful where the validity bit is set
+    uint64_t* validity; // one bit per slot, 1 = used
+    int capacity; // total number of slots
+} BitmapArray;
+
+int Bitmap_Array_Init(BitmapArray* bitmap, int capacity); // allocates an empty array, returns 0 on success or -1 if out of memory
+void Bitmap_Array_Free(BitmapArray* bitmap); // releases the buffers allocated by Bitmap_Array_Init()
+void Bitmap_Array_Clear(BitmapArray* bitmap); // marks every slot unused
+void Bitmap_Array_Set(BitmapArray* bitmap, int index, int value); // stores any value (negatives allowed) and marks the slot used
+void Bitmap_Array_Unset(BitmapArray* bitmap, int index); // marks a slot unused
+int Bitmap_Array_Is_Used(const BitmapArray* bitmap, int index); // returns 1 if the slot is used, 0 otherwise
+int Bitmap_Array_From_Sentinel(BitmapArray* bitmap, const int array[], int capacity); // builds a bitmap array from a sentinel array, returns 0 or -1
+int Bitmap_Array_To_Sentinel(const BitmapArray* bitmap, int array[]); // writes a sentinel array, returns how many negative values could not be represented
+int Bitmap_Array_Count(const BitmapArray* bitmap); // number of used slots, by popcount
+void Bitmap_Array_Stats(const BitmapArray* bitmap, Array_Statistics* stats); // all summary statistics of the used slots in one pass
+
+#endif // BITMAP_ARRAY_HEADER_H
@@ -0,0 +1,246 @@
+/**
+ * @file Generic_Kernels_Functions.c
+ * @brief Type-specialised sort, select, min/max and statistics kernels
+ *
+ * GENERIC_DEFINE holds one copy of every kernel written against a
+ * placeholder element type. GENERIC_TYPES expands it once for int32,
+ * int64, float and double, so each specialisation is ordinary C compiled
+ * for its own type: callers with int64 counters or double measurements
+ * no longer have to convert whole arrays to int first.
+ */
+
+#include "Generic_Kernels_Header.h" // linking the header definitions
+#include "Sort_Operations_Header.h" // linking INSERTION_SORT_THRESHOLD
+#include <stdlib.h>
+#include <math.h>
+
+#define GENERIC_DEFINE(suffix, type, is_used, unused) \
+\
+/* Marks every element unused (WF4) */ \
+void Clear_Array_##suffix(type array[], int capacity) { \
+    for (int i = 0; i < capacity; i++) { \
+        array[i] = unused; \
+    } \
+} \
+\
+/* Stable compaction of the used elements into a dense prefix */ \
+int Compact_Used_##suffix(type array[], int capacity) { \
+    int used = 0; \
+    for (int i = 0; i < capacity; i++) { \
+        if (is_used(array[i])) { \
+            array[used++] = array[i]; \
+        } \
+    } \
+    for (int i = used; i < capacity; i++) { \
+        array[i] = unused; \
+    } \
+    return used; \
+} \
+\
+static void Insertion_Sort_##suffix(type data[], int low, int high) { \
+    for (int i = low + 1; i <= high; i++) { \
+        type value = data[i]; \
+        int j = i - 1; \
+        while (j >= low && data[j] > value) { \
+            data[j + 1] = data[j]; \
+            j--; \
+        } \
+        data[j + 1] = value; \
+    } \
+} \
+\
+static void Sift_Down_##suffix(type data[], int root, int count) { \
+    type value = data[root]; \
+    for (;;) { \
+        int child = 2 * root + 1; \
+        if (child >= count) { \
+            break; \
+        } \
+        if (child + 1 < count && data[child + 1] > data[child]) { \
+            child++; \
+        } \
+        if (data[child] <= value) { \
+            break; \
+        } \
+        data[root] = data[child]; \
+        root = child; \
+    } \
+    data[root] = value; \
+} \
+\
+static void Heap_Sort_##suffix(type data[], int count) { \
+    for (int i = count / 2 - 1; i >= 0; i--) { \
+        Sift_Down_##suffix(data, i, count); \
+    } \
+    for (int end = count - 1; end > 0; end--) { \
+        type temp = data[0]; \
+        data[0] = data[end]; \
+        data[end] = temp; \
+        Sift_Down_##suffix(data, 0, end); \
+    } \
+} \
+\
+/* Median of data[low], data[mid] and data[high] */ \
+static type Median_Of_Three_##suffix(const type data[], int low, int high) { \
+    type a = data[low], b = data[low + (high - low) / 2], c = data[high]; \
+    return (a < b) ? ((b < c) ? b : ((a < c) ? c : a)) \
+                   : ((a < c) ? a : ((b < c) ? c : b)); \
+} \
+\
+/* Introsort step: Hoare partition, recurse into the smaller side */ \
+static void Intro_Sort_Range_##suffix(type data[], int low, int high, int depth_limit) { \
+    while (high - low + 1 > INSERTION_SORT_THRESHOLD) { \
+        if (depth_limit-- == 0) { \
+            Heap_Sort_##suffix(data + low, high - low + 1); \
+            return; \
+        } \
+        type pivot = Median_Of_Three_##suffix(data, low, high); \
+        int i = low - 1; \
+        int j = high + 1; \
+        for (;;) { \
+            do { i++; } while (data[i] < pivot); \
+            do { j--; } while (data[j] > pivot); \
+            if (i >= j) { \
+                break; \
+            } \
+            type temp = data[i]; \
+            data[i] = data[j]; \
+            data[j] = temp; \
+        } \
+        if (j - low < high - j) { \
+            Intro_Sort_Range_##suffix(data, low, j, depth_limit); \
+            low = j + 1; \
+        } \
+        else { \
+            Intro_Sort_Range_##suffix(data, j + 1, high, depth_limit); \
+            high = j; \
+        } \
+    } \
+    Insertion_Sort_##suffix(data, low, high); \
+} \
+\
+/* Introsort of a dense buffer of used values */ \
+void Sort_Dense_##suffix(type data[], int count) { \
+    int depth_limit = 0; \
+    for (int n = count; n > 1; n >>= 1) { \
+        depth_limit += 2; \
+    } \
+    if (count > 1) { \
+        Intro_Sort_Range_##suffix(data, 0, count - 1, depth_limit); \
+    } \
+} \
+\
+/* Compacts and sorts the used elements (WF5) */ \
+int Sort_Array_##suffix(type array[], int capacity) { \
+    int used = Compact_Used_##suffix(array, capacity); \
+    Sort_Dense_##suffix(array, used); \
+    return used; \
+} \
+\
+/* Three-way quickselect; a range that stays large too long is sorted */ \
+type Select_Nth_##suffix(type data[], int count, int k) { \
+    int low = 0; \
+    int high = count - 1; \
+    int depth_limit = 0; \
+    for (int n = count; n > 1; n >>= 1) { \
+        depth_limit += 2; \
+    } \
+    while (high > low) { \
+        if (high - low + 1 <= INSERTION_SORT_THRESHOLD || depth_limit-- == 0) { \
+            Intro_Sort_Range_##suffix(data, low, high, depth_limit > 0 ? depth_limit : 0); \
+            break; \
+        } \
+        type pivot = Median_Of_Three_##suffix(data, low, high); \
+        int less = low; \
+        int i = low; \
+        int greater = high; \
+        while (i <= greater) { \
+            type value = data[i]; \
+            if (value < pivot) { \
+                data[i++] = data[less]; \
+                data[less++] = value; \
+            } \
+            else if (value > pivot) { \
+                data[i] = data[greater]; \
+                data[greater--] = value; \
+            } \
+            else { \
+                i++; \
+            } \
+        } \
+        if (k < less) { \
+            high = less - 1; \
+        } \
+        else if (k > greater) { \
+            low = greater + 1; \
+        } \
+        else { \
+            break; \
+        } \
+    } \
+    return data[k]; \
+} \
+\
+/* Extremes of the used elements (WF9, WF10) */ \
+int Min_Max_##suffix(const type array[], int capacity, type* min, type* max) { \
+    int used = 0; \
+    type low = unused; \
+    type high = unused; \
+    for (int i = 0; i < capacity; i++) { \
+        type value = array[i]; \
+        if (is_used(value)) { \
+            if (used == 0 || value < low) { \
+                low = value; \
+            } \
+            if (used == 0 || value > high) { \
+                high = value; \
+            } \
+            used++; \
+        } \
+    } \
+    *min = low; \
+    *max = high; \
+    return used; \
+} \
+\
+/* Count, sum, extremes, mean and variance in one pass, deviations taken */ \
+/* from the first used value so large offsets do not cost precision */ \
+void Array_Stats_##suffix(const type array[], int capacity, Array_Statistics_##suffix* stats) { \
+    int count = 0; \
+    double shift = 0.0; \
+    double shifted_sum = 0.0; \
+    double sum_squares = 0.0; \
+    type low = unused; \
+    type high = unused; \
+    for (int i = 0; i < capacity; i++) { \
+        type value = array[i]; \
+        if (is_used(value)) { \
+            if (count == 0) { \
+                shift = (double)value; \
+                low = value; \
+                high = value; \
+            } \
+            double deviation = (double)value - shift; \
+            shifted_sum += deviation; \
+            sum_squares += deviation * deviation; \
+            low = (value < low) ? value : low; \
+            high = (value > high) ? value : high; \
+            count++; \
+        } \
+    } \
+    stats->count = count; \
+    stats->min = low; \
+    stats->max = high; \
+    stats->sum = shift * count + shifted_sum; \
+    stats->mean = 0.0; \
+    stats->variance = 0.0; \
+    stats->standard_deviation = 0.0; \
+    if (count > 0) { \
+        double variance = (sum_squares - shifted_sum * shifted_sum / count) / count; \
+        stats->mean = shift + shifted_sum / count; \
+        stats->variance = (variance > 0.0) ? variance : 0.0; \
+        stats->standard_deviation = sqrt(stats->variance); \
+    } \
+}
+
+GENERIC_TYPES(GENERIC_DEFINE)
@@ -0,0 +1,75 @@
+#ifndef GENERIC_KERNELS_HEADER_H
+#define GENERIC_KERNELS_HEADER_H // include guard
+
+// Sort, select, min/max and statistics kernels for int32, int64, float and
+// double arrays. Each kernel is written once in Generic_Kernels_Functions.c
+// and specialised per element type by the GENERIC_TYPES X-macro, so the
+// inner loops are compiled for one type with no runtime type switch. The
+// _g macros pick the specialisation from the array type with _Generic
+// (needs C11, set by LanguageStandard_C in the project).
+
+#include <stdint.h>
+#include <math.h>
+#include "Main_Header.h" // include main header for macros
+
+// Unused-element policy per type: integers keep the UNUSED_MARKER
+// convention (negative is unused), floating point uses NaN so that
+// negative measurements stay valid.
+#define IS_USED_I32(value) ((value) >= 0)
+#define IS_USED_I64(value) ((value) >= 0)
+#define IS_USED_F32(value) ((value) == (value)) // false only for NaN
+#define IS_USED_F64(value) ((value) == (value)) // false only for NaN
+#define UNUSED_I32 ((int32_t)UNUSED_MARKER)
+#define UNUSED_I64 ((int64_t)UNUSED_MARKER)
+#define UNUSED_F32 ((float)NAN)
+#define UNUSED_F64 ((double)NAN)
+
+// X(suffix, element type, used test, unused value)
+#define GENERIC_TYPES(X) \
+    X(i32, int32_t, IS_USED_I32, UNUSED_I32) \
+    X(i64, int64_t, IS_USED_I64, UNUSED_I64) \
+    X(f32, float, IS_USED_F32, UNUSED_F32) \
+    X(f64, double, IS_USED_F64, UNUSED_F64)
+
+/**
+ * @brief Per-type statistics and kernel prototypes
+ *
+ * Statistics keep min and max in the element type so int64 extremes are
+ * exact; the moments are accumulated in double around the first used
+ * value to stay accurate.
+ */
+#define GENERIC_DECLARE(suffix, type, is_used, unused) \
+    typedef struct Array_Statistics_##suffix { \
+        int count; /* number of used elements */ \
+        type min; /* smallest used element, unused value if none */ \
+        type max; /* largest used element, unused value if none */ \
+        double sum; /* sum of used elements */ \
+        double mean; /* arithmetic mean, 0 if no used elements */ \
+        double variance; /* population variance, 0 if no used elements */ \
+        double standard_deviation; /* square root of the variance */ \
+    } Array_Statistics_##suffix; \
+    void Clear_Array_##suffix(type array[], int capacity); /* marks every element unused */ \
+    int Compact_Used_##suffix(type array[], int capacity); /* packs used elements at the front, returns the used count */ \
+    void Sort_Dense_##suffix(type data[], int count); /* introsort of a buffer holding only used values */ \
+    int Sort_Array_##suffix(type array[], int capacity); /* compacts and sorts the used elements, returns the used count */ \
+    type Select_Nth_##suffix(type data[], int count, int k); /* k-th smallest of a dense buffer in O(n), rearranging it */ \
+    int Min_Max_##suffix(const type array[], int capacity, type* min, type* max); /* extremes of the used elements, returns the used count */ \
+    void Array_Stats_##suffix(const type array[], int capacity, Array_Statistics_##suffix* stats); /* all summary statistics in one pass */
+
+GENERIC_TYPES(GENERIC_DECLARE)
+
+// Type-generic front end: the specialisation is chosen at compile time
+// from the (non-const) array pointer type.
+#define GENERIC_SELECT(array, name) _Generic((array), \
+    int32_t*: name##_i32, \
+    int64_t*: name##_i64, \
+    float*: name##_f32, \
+    double*: name##_f64)
+
+#define Clear_Array_g(array, capacity) GENERIC_SELECT(array, Clear_Array)(array, capacity) // WF4 for any element type
+#define Sort_Array_g(array, capacity) GENERIC_SELECT(array, Sort_Array)(array, capacity) // WF5 for any element type
+#define Select_Nth_g(data, count, k) GENERIC_SELECT(data, Select_Nth)(data, count, k) // k-th smallest for any element type
+#define Min_Max_g(array, capacity, min, max) GENERIC_SELECT(array, Min_Max)(array, capacity, min, max) // WF9 and WF10 for any element type
+#define Array_Stats_g(array, capacity, stats) GENERIC_SELECT(array, Array_Stats)(array, capacity, stats) // statistics for any element type
+
+#endif // GENERIC_KERNELS_HEADER_H
@@ -0,0 +1,227 @@
+/**
+ * @file Histogram_Operation_Functions.c
+ * @brief Count-table engine for arrays with a small value range
+ *
+ * Array_Random() fills from a known small [min, max], and so does most
+ * real data. When the range is small next to the number of elements, one
+ * pass that counts each value gives a counting sort, any order statistic,
+ * the mode and the distinct count in O(n + range), with no comparisons.
+ * Sort_Dense(), Median_Average() and Array_Nth() switch to this engine on
+ * their own when Histogram_Fits() says it pays off.
+ */
+
+#include "Histogram_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include "Arena_Header.h" // linking the scratch arena
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief Finds the smallest and largest used value in one pass
+ *
+ * @param[in] array Array to scan, unused elements are skipped
+ * @param[in] capacity Total number of elements in the array
+ * @param[out] min Smallest used value, UNUSED_MARKER if there are none
+ * @param[out] max Largest used value, UNUSED_MARKER if there are none
+ * @return int Number of used elements
+ */
+int Histogram_Bounds(const int array[], int capacity, int* min, int* max) {
+    int low = 0x7fffffff; /**< Smallest value so far */
+    int high = UNUSED_MARKER; /**< Largest value so far, any used value beats it */
+    int used = 0;
+
+    for (int i = 0; i < capacity; i++) {
+        int value = array[i];
+        if (IS_USED(value)) {
+            used++;
+            low = (value < low) ? value : low;
+            high = (value > high) ? value : high;
+        }
+    }
+    *min = (used > 0) ? low : UNUSED_MARKER;
+    *max = high;
+    return used;
+}
+
+/**
+ * @brief Decides whether a count table beats a comparison or radix sort
+ *
+ * The table has max - min + 1 slots that must be cleared and walked, so
+ * it pays off only when that is not much more than the number of values
+ * and the table stays small enough to live in cache.
+ *
+ * @param[in] min Smallest value
+ * @param[in] max Largest value
+ * @param[in] count Number of values
+ * @return int Non-zero if the histogram engine should be used
+ */
+int Histogram_Fits(int min, int max, int count) {
+    long long range = (long long)max - min + 1; /**< Slots in the table */
+
+    return count >= HISTOGRAM_MIN_COUNT && min >= 0 && range <= HISTOGRAM_MAX_RANGE
+        && range <= (long long)count * HISTOGRAM_RANGE_RATIO;
+}
+
+/**
+ * @brief Counts the used values of an array
+ *
+ * The table is allocated from the scratch arena; the caller takes a mark
+ * before the call and restores it when done with the histogram. Values
+ * outside [min, max], including UNUSED_MARKER, are not counted.
+ *
+ * @param[out] histogram Histogram to fill
+ * @param[in] array Array to count, may be a sentinel array or a dense buffer
+ * @param[in] capacity Total number of elements in the array
+ * @param[in] min Smallest value to count, at least 0
+ * @param[in] max Largest value to count
+ * @return int 0 on success, -1 if the table could not be allocated
+ */
+int Histogram_Build(Histogram* histogram, const int array[], int capacity, int min, int max) {
+    unsigned int range = (unsigned int)(max - min) + 1u; /**< Slots in the table */
+    int* counts = Arena_Alloc(Scratch_Arena(), (size_t)range * sizeof(int));
+    int total = 0;
+
+    if (counts == NULL) {
+        return -1;
+    }
+    memset(counts, 0, (size_t)range * sizeof(int));
+    for (int i = 0; i < capacity; i++) {
+        unsigned int slot = (unsigned int)array[i] - (unsigned int)min; /**< Unused and out-of-range values wrap past range */
+        if (slot < range) {
+            counts[slot]++;
+            total++;
+        }
+    }
+    histogram->min = min;
+    histogram->max = max;
+    histogram->total = total;
+    histogram->counts = counts;
+    return 0;
+}
+
+/**
+ * @brief Writes the counted values in ascending order (counting sort)
+ *
+ * @param[in] histogram Histogram to expand
+ * @param[out] data Buffer of at least histogram->total elements
+ *
+ * @return void
+ *
+ * @note O(n + range), no comparisons
+ */
+void Histogram_Sort(const Histogram* histogram, int data[]) {
+    int range = histogram->max - histogram->min + 1;
+    int position = 0;
+
+    for (int slot = 0; slot < range; slot++) {
+        int value = histogram->min + slot;
+        for (int c = histogram->counts[slot]; c > 0; c--) {
+            data[position++] = value;
+        }
+    }
+}
+
+/**
+ * @brief Returns the k-th smallest counted value
+ *
+ * @param[in] histogram Histogram to read
+ * @param[in] k Zero-based rank (0 is the minimum)
+ * @return int The k-th smallest value, UNUSED_MARKER if k is out of range
+ */
+int Histogram_Nth(const Histogram* histogram, int k) {
+    int range = histogram->max - histogram->min + 1;
+    int seen = 0; /**< Values at or below the current slot */
+
+    if (k < 0 || k >= histogram->total) {
+        return UNUSED_MARKER;
+    }
+    for (int slot = 0; slot < range; slot++) {
+        seen += histogram->counts[slot];
+        if (seen > k) {
+            return histogram->min + slot;
+        }
+    }
+    return UNUSED_MARKER;
+}
+
+/**
+ * @brief Returns the median of the counted values
+ *
+ * For an even count the two middle values are averaged and rounded toward
+ * zero, exactly as Median_Select() does.
+ *
+ * @param[in] histogram Histogram to read
+ * @return int Median value, 0 if nothing was counted
+ */
+int Histogram_Median(const Histogram* histogram) {
+    int total = histogram->total;
+
+    if (total == 0) {
+        return 0;
+    }
+    int upper = Histogram_Nth(histogram, total / 2); /**< Upper (or only) middle value */
+    if (total % 2 != 0) {
+        return upper;
+    }
+    return (int)(((long long)Histogram_Nth(histogram, total / 2 - 1) + upper) / 2);
+}
+
+/**
+ * @brief Returns a percentile of the counted values by the nearest-rank method
+ *
+ * The result is the smallest value with at least percentile% of the
+ * values at or below it, so it is always one of the counted values.
+ *
+ * @param[in] histogram Histogram to read
+ * @param[in] percentile Percentile to return, clamped to [0, 100]
+ * @return int Percentile value, UNUSED_MARKER if nothing was counted
+ */
+int Histogram_Percentile(const Histogram* histogram, double percentile) {
+    int total = histogram->total;
+
+    if (total == 0) {
+        return UNUSED_MARKER;
+    }
+    double rank = ceil(percentile / 100.0 * total); /**< One-based nearest rank */
+    int k = (rank < 1.0) ? 0 : (rank > total) ? total - 1 : (int)rank - 1;
+    return Histogram_Nth(histogram, k);
+}
+
+/**
+ * @brief Returns the most frequent counted value
+ *
+ * @param[in] histogram Histogram to read
+ * @param[out] frequency Occurrences of the mode, may be NULL
+ * @return int Most frequent value (the smallest one on ties), UNUSED_MARKER if nothing was counted
+ */
+int Histogram_Mode(const Histogram* histogram, int* frequency) {
+    int range = histogram->max - histogram->min + 1;
+    int best = 0; /**< Slot of the mode so far */
+
+    for (int slot = 1; slot < range; slot++) {
+        if (histogram->counts[slot] > histogram->counts[best]) {
+            best = slot;
+        }
+    }
+    if (frequency != NULL) {
+        *frequency = (histogram->total > 0) ? histogram->counts[best] : 0;
+    }
+    return (histogram->total > 0) ? histogram->min + best : UNUSED_MARKER;
+}
+
+/**
+ * @brief Returns the number of different values counted
+ *
+ * @param[in] histogram Histogram to read
+ * @return int Number of non-empty slots
+ */
+int Histogram_Distinct(const Histogram* histogram) {
+    int range = histogram->max - histogram->min + 1;
+    int distinct = 0;
+
+    for (int slot = 0; slot < range; slot++) {
+        distinct += (histogram->counts[slot] != 0);
+    }
+    return distinct;
+}
@@ -0,0 +1,34 @@
+#ifndef HISTOGRAM_OPERATIONS_HEADER_H
+#define HISTOGRAM_OPERATIONS_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+
+#define HISTOGRAM_MIN_COUNT 64 // fewer used elements than this are not worth a count table
+#define HISTOGRAM_MAX_RANGE (1 << 20) // widest value range given a count table (4 MiB of counts)
+#define HISTOGRAM_RANGE_RATIO 2 // the value range may be at most this many times the element count
+
+/**
+ * @brief Count table of the used values in [min, max]
+ *
+ * Built in one pass by Histogram_Build(). Every order statistic, the
+ * mode and the distinct count are then read from the table in
+ * O(max - min) without touching the data again.
+ */
+typedef struct Histogram {
+    int min; // value counted in counts[0]
+    int max; // value counted in counts[max - min]
+    int total; // number of values counted
+    int* counts; // occurrences of each value, held in the scratch arena
+} Histogram;
+
+int Histogram_Bounds(const int array[], int capacity, int* min, int* max); // smallest and largest used value (UNUSED_MARKER if none), returns the used count
+int Histogram_Fits(int min, int max, int count); // non-zero if a count table over [min, max] is cheaper than sorting count values
+int Histogram_Build(Histogram* histogram, const int array[], int capacity, int min, int max); // counts the used values in [min, max], returns 0 on success or -1 if out of memory
+void Histogram_Sort(const Histogram* histogram, int data[]); // writes the counted values to data in ascending order (counting sort)
+int Histogram_Nth(const Histogram* histogram, int k); // k-th smallest counted value, UNUSED_MARKER if k is out of range
+int Histogram_Median(const Histogram* histogram); // median of the counted values, rounded as Median_Select()
+int Histogram_Percentile(const Histogram* histogram, double percentile); // nearest-rank percentile, percentile in [0, 100]
+int Histogram_Mode(const Histogram* histogram, int* frequency); // most frequent value (smallest on ties) and its frequency
+int Histogram_Distinct(const Histogram* histogram); // number of different values counted
+
+#endif // HISTOGRAM_OPERATIONS_HEADER_H
@@ -0,0 +1,582 @@
+/**
+ * @file Int_Array_Functions.c
+ * @brief Implementation of the dense IntArray handle and its WF variants
+ *
+ * An IntArray keeps its used elements packed at the front of the buffer
+ * and tracks how many there are, so the count is O(1) and every kernel
+ * runs over the dense prefix only instead of stepping over unused holes.
+ * Int_Array_Wrap() adapts an existing sentinel array to a handle.
+ *
+ * Each handle also caches the moments of its used prefix and whether the
+ * prefix is sorted, so repeated queries between small updates do not
+ * rescan the data.
+ */
+
+#include "Int_Array_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include "Simple_Operations_Header.h" // linking the simple operations header definitions
+#include "Matrice_Operations_Header.h" // linking the matrice operations header definitions
+#include "Sort_Operations_Header.h" // linking the sort engine
+#include "Output_Operations_Header.h" // linking the buffered output engine
+#include "Arena_Header.h" // linking the scratch arena
+#include "Profile_Header.h" // linking the optional profiling probes
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+/**
+ * @brief Marks the cache as describing an empty, trivially sorted array
+ *
+ * @param[out] cache Cache to reset
+ */
+static void Cache_Empty(Int_Array_Cache* cache) {
+    cache->valid = 1;
+    cache->is_sorted = 1;
+    cache->moments.count = 0;
+    cache->moments.sum = 0;
+    cache->moments.min = INT_MAX;
+    cache->moments.max = INT_MIN;
+    cache->moments.shift = 0;
+    cache->moments.sum_squares = 0.0;
+}
+
+/**
+ * @brief Adds one used value to cached moments
+ *
+ * @param[in,out] moments Moments to update
+ * @param[in] value Value joining the used prefix
+ */
+static void Cache_Add(Array_Moments* moments, int value) {
+    if (moments->count == 0) {
+        moments->shift = value; /**< First value becomes the shift, as in a scan */
+    }
+    double deviation = (double)value - moments->shift;
+    moments->count++;
+    moments->sum += value;
+    moments->sum_squares += deviation * deviation;
+    if (value < moments->min) {
+        moments->min = value;
+    }
+    if (value > moments->max) {
+        moments->max = value;
+    }
+}
+
+/**
+ * @brief Makes sure the cached moments describe the used prefix
+ *
+ * @param[in,out] handle Handle whose cache is filled on a miss
+ */
+static void Cache_Fill(IntArray* handle) {
+    if (!handle->cache.valid) {
+        Moments_Reduce(handle->data, handle->used, &handle->cache.moments);
+        handle->cache.valid = 1;
+    }
+}
+
+ /**
+  * @brief Adapts a sentinel array to a dense handle
+  *
+  * Compacts the used elements of array into a dense prefix in place
+  * (keeping their order) and records the used count, so the handle can be
+  * passed to the _h functions. The buffer stays owned by the caller.
+  *
+  * @param[out] handle Handle to initialise
+  * @param[in,out] array Sentinel array to adapt
+  * @param[in] capacity Total number of elements in the array
+  *
+  * @return void
+  *
+  * @code
+  * int arr[5] = {5, UNUSED, 3, 1, UNUSED};
+  * IntArray handle;
+  * Int_Array_Wrap(&handle, arr, 5); // arr = {5, 3, 1, UNUSED, UNUSED}, handle.used = 3
+  * @endcode
+  */
+void Int_Array_Wrap(IntArray* handle, int array[], int capacity) {
+    handle->data = array;
+    handle->capacity = capacity;
+    handle->used = Compact_Used(array, capacity);
+    handle->owned = 0;
+    Int_Array_Invalidate(handle);
+}
+
+/**
+ * @brief Allocates an empty heap-backed array
+ *
+ * Every slot starts as UNUSED_MARKER. Large arrays live on the heap, so
+ * the capacity is limited by memory rather than by the stack.
+ *
+ * @param[out] handle Handle to initialise
+ * @param[in] capacity Number of slots to allocate
+ * @return int 0 on success, -1 if memory could not be allocated
+ */
+int Int_Array_Init(IntArray* handle, int capacity) {
+    handle->data = NULL;
+    handle->used = 0;
+    handle->capacity = 0;
+    handle->owned = 0;
+    Cache_Empty(&handle->cache);
+    return Int_Array_Reserve(handle, capacity);
+}
+
+/**
+ * @brief Grows the buffer to hold at least capacity slots
+ *
+ * The capacity at least doubles on each growth, so a sequence of pushes
+ * costs amortised O(1) per element. New slots are set to UNUSED_MARKER.
+ * A wrapped buffer is copied to the heap rather than reallocated.
+ *
+ * @param[in,out] handle Handle to grow
+ * @param[in] capacity Number of slots needed
+ * @return int 0 on success (including when no growth was needed), -1 if out of memory
+ */
+int Int_Array_Reserve(IntArray* handle, int capacity) {
+    int grown = (handle->capacity > 0) ? handle->capacity : INT_ARRAY_MIN_CAPACITY;
+    int* data;
+
+    if (capacity <= handle->capacity && handle->data != NULL) {
+        return 0;
+    }
+    while (grown < capacity) {
+        grown = (grown > INT_MAX / 2) ? INT_MAX : grown * 2;
+    }
+    if (handle->owned) {
+        data = realloc(handle->data, (size_t)grown * sizeof(int));
+    }
+    else {
+        data = malloc((size_t)grown * sizeof(int));
+        if (data != NULL && handle->capacity > 0) {
+            memcpy(data, handle->data, (size_t)handle->capacity * sizeof(int)); /**< Leave the caller's buffer untouched */
+        }
+    }
+    if (data == NULL) {
+        return -1;
+    }
+    for (int i = handle->capacity; i < grown; i++) {
+        data[i] = UNUSED_MARKER;
+    }
+    handle->data = data;
+    handle->capacity = grown;
+    handle->owned = 1;
+    return 0;
+}
+
+/**
+ * @brief Appends a used value at the end of the dense prefix
+ *
+ * @param[in,out] handle Handle to append to
+ * @param[in] value Non-negative value to append
+ * @return int 0 on success, -1 if value is not a used value or the buffer could not grow
+ */
+int Int_Array_Push(IntArray* handle, int value) {
+    if (!IS_USED(value)) {
+        return -1; /**< A negative value would break the dense-used prefix */
+    }
+    if (handle->used == handle->capacity) {
+        if (handle->capacity == INT_MAX || Int_Array_Reserve(handle, handle->capacity + 1) != 0) {
+            return -1;
+        }
+    }
+    if (handle->used > 0 && value < handle->data[handle->used - 1]) {
+        handle->cache.is_sorted = 0;
+    }
+    if (handle->cache.valid) {
+        Cache_Add(&handle->cache.moments, value);
+    }
+    handle->data[handle->used++] = value;
+    return 0;
+}
+
+/**
+ * @brief Overwrites one used element and updates the cache in O(1)
+ *
+ * The sums are adjusted by the difference between the old and new value.
+ * Only when the old value was the minimum or maximum and the new one does
+ * not replace it are the moments dropped, to be rescanned on the next
+ * query. The sorted flag survives if the new value still fits between its
+ * neighbours.
+ *
+ * @param[in,out] handle Handle to modify
+ * @param[in] index Position in the used prefix, 0 to used - 1
+ * @param[in] value New non-negative value
+ * @return int 0 on success, -1 if index is outside the used prefix or value is negative
+ */
+int Int_Array_Set(IntArray* handle, int index, int value) {
+    Int_Array_Cache* cache = &handle->cache;
+
+    if (index < 0 || index >= handle->used || !IS_USED(value)) {
+        return -1;
+    }
+    int old = handle->data[index]; /**< Value being replaced */
+    handle->data[index] = value;
+
+    if (cache->is_sorted
+        && ((index > 0 && handle->data[index - 1] > value)
+            || (index < handle->used - 1 && value > handle->data[index + 1]))) {
+        cache->is_sorted = 0;
+    }
+    if (!cache->valid) {
+        return 0;
+    }
+    if ((old == cache->moments.min && value > old) || (old == cache->moments.max && value < old)) {
+        cache->valid = 0; /**< An extreme left and the new extreme is unknown */
+        return 0;
+    }
+    double old_deviation = (double)old - cache->moments.shift;
+    double new_deviation = (double)value - cache->moments.shift;
+    cache->moments.sum += (long long)value - old;
+    cache->moments.sum_squares += new_deviation * new_deviation - old_deviation * old_deviation;
+    if (value < cache->moments.min) {
+        cache->moments.min = value;
+    }
+    if (value > cache->moments.max) {
+        cache->moments.max = value;
+    }
+    return 0;
+}
+
+/**
+ * @brief Forgets the cached statistics and sorted flag
+ *
+ * Call after writing handle->data directly, or after passing it to one of
+ * the (array, capacity) functions that modify it.
+ *
+ * @param[in,out] handle Handle whose data changed
+ *
+ * @return void
+ */
+void Int_Array_Invalidate(IntArray* handle) {
+    handle->cache.valid = 0;
+    handle->cache.is_sorted = 0;
+}
+
+/**
+ * @brief Releases the buffer if the handle allocated it
+ *
+ * A wrapped buffer that never grew still belongs to the caller and is
+ * left alone. The handle is left empty.
+ *
+ * @param[in,out] handle Handle to release
+ *
+ * @return void
+ */
+void Int_Array_Free(IntArray* handle) {
+    if (handle->owned) {
+        free(handle->data);
+    }
+    handle->data = NULL;
+    handle->used = 0;
+    handle->capacity = 0;
+    handle->owned = 0;
+    Cache_Empty(&handle->cache);
+}
+
+/**
+ * @brief Reads values from the keyboard into the handle (WF2)
+ *
+ * @param[in,out] handle Handle whose buffer receives the input
+ *
+ * @return void
+ *
+ * @see Keyboard_Input()
+ */
+void Keyboard_Input_h(IntArray* handle) {
+    int used = 0;
+
+    Keyboard_Input(handle->data, handle->capacity);
+    while (used < handle->capacity && IS_USED(handle->data[used])) {
+        used++; /**< Input stops at the first unused slot, so the prefix is already dense */
+    }
+    handle->used = used;
+    Int_Array_Invalidate(handle);
+}
+
+/**
+ * @brief Fills the first size slots with random numbers (WF3)
+ *
+ * @param[in,out] handle Handle to fill
+ * @param[in] size Number of elements to fill, clamped to the capacity
+ * @param[in] min Minimum value for random numbers (inclusive)
+ * @param[in] max Maximum value for random numbers (inclusive)
+ *
+ * @return void
+ *
+ * @see Array_Random()
+ */
+void Array_Random_h(IntArray* handle, int size, int min, int max) {
+    if (size > handle->capacity) {
+        size = handle->capacity;
+    }
+    Array_Random(handle->data, size, handle->capacity, min, max);
+    handle->used = size;
+    Int_Array_Invalidate(handle);
+}
+
+/**
+ * @brief Clears the handle (WF4)
+ *
+ * Only the used prefix has to be reset, because the tail already holds
+ * UNUSED_MARKER.
+ *
+ * @param[in,out] handle Handle to clear
+ *
+ * @return void
+ */
+void Clear_Array_h(IntArray* handle) {
+    Clear_Array(handle->data, handle->used);
+    handle->used = 0;
+    Cache_Empty(&handle->cache);
+}
+
+/**
+ * @brief Sorts the used prefix in ascending order (WF5)
+ *
+ * @param[in,out] handle Handle to sort
+ *
+ * @return void
+ *
+ * @see Sort_Dense()
+ */
+void Sort_Array_h(IntArray* handle) {
+    PROFILE_ENTER();
+    if (!handle->cache.is_sorted) {
+        Sort_Dense(handle->data, handle->used);
+        handle->cache.is_sorted = 1; /**< The values are unchanged, so the moments stay valid */
+    }
+    PROFILE_EXIT(PROBE_SORT_ARRAY_H, handle->used);
+}
+
+/**
+ * @brief Randomizes the order of the used prefix (WF6)
+ *
+ * Unused slots are not touched, so the prefix stays dense. The values
+ * themselves do not change, so only the sorted flag is dropped.
+ *
+ * @param[in,out] handle Handle to shuffle
+ *
+ * @return void
+ *
+ * @see Shuffle_Array()
+ */
+void Shuffle_Array_h(IntArray* handle) {
+    if (handle->used > 0) {
+        Shuffle_Array(handle->data, handle->used);
+        handle->cache.is_sorted = (handle->used == 1);
+    }
+}
+
+/**
+ * @brief Prints the used elements of the handle (WF7)
+ *
+ * @param[in] handle Handle to display
+ *
+ * @return void
+ */
+void Print_Used_h(const IntArray* handle) {
+    Output_Array(Output_Stdout(), handle->data, handle->used, Output_Layout(), 0);
+    Output_Flush(Output_Stdout());
+}
+
+/**
+ * @brief Prints every slot of the handle including unused markers (WF8)
+ *
+ * @param[in] handle Handle to display
+ *
+ * @return void
+ */
+void Print_All_h(const IntArray* handle) {
+    Output_Array(Output_Stdout(), handle->data, handle->capacity, Output_Layout(), 0);
+    Output_Flush(Output_Stdout());
+}
+
+/**
+ * @brief Returns every summary statistic of the used prefix
+ *
+ * The prefix is scanned only if the cached moments were invalidated;
+ * otherwise the statistics are derived from the cache in O(1).
+ *
+ * @param[in,out] handle Handle to analyse
+ * @param[out] stats Structure receiving the statistics
+ *
+ * @return void
+ *
+ * @see Array_Stats()
+ */
+void Array_Stats_h(IntArray* handle, Array_Statistics* stats) {
+    PROFILE_ENTER();
+    Cache_Fill(handle);
+    Stats_From_Moments(&handle->cache.moments, stats);
+    PROFILE_EXIT(PROBE_ARRAY_STATS_H, handle->used);
+}
+
+/**
+ * @brief Returns the minimum used value (WF9)
+ *
+ * @param[in,out] handle Handle to search
+ * @return int Minimum used value, UNUSED_MARKER if the handle is empty
+ *
+ * @note O(1) when the handle is sorted or its statistics are cached
+ */
+int Find_Min_h(IntArray* handle) {
+    PROFILE_ENTER();
+    int min;
+
+    if (handle->cache.is_sorted) {
+        min = (handle->used > 0) ? handle->data[0] : UNUSED_MARKER;
+    }
+    else {
+        Array_Statistics stats;
+        Array_Stats_h(handle, &stats);
+        min = stats.min;
+    }
+    PROFILE_EXIT(PROBE_FIND_MIN_H, handle->used);
+    return min;
+}
+
+/**
+ * @brief Returns the maximum used value (WF10)
+ *
+ * @param[in,out] handle Handle to search
+ * @return int Maximum used value, UNUSED_MARKER if the handle is empty
+ *
+ * @note O(1) when the handle is sorted or its statistics are cached
+ */
+int Find_Max_h(IntArray* handle) {
+    PROFILE_ENTER();
+    int max;
+
+    if (handle->cache.is_sorted) {
+        max = (handle->used > 0) ? handle->data[handle->used - 1] : UNUSED_MARKER;
+    }
+    else {
+        Array_Statistics stats;
+        Array_Stats_h(handle, &stats);
+        max = stats.max;
+    }
+    PROFILE_EXIT(PROBE_FIND_MAX_H, handle->used);
+    return max;
+}
+
+/**
+ * @brief Returns the number of used elements in O(1)
+ *
+ * @param[in] handle Handle to query
+ * @return int Number of used elements
+ */
+int Num_of_Used_Elements_h(const IntArray* handle) {
+    return handle->used;
+}
+
+/**
+ * @brief Returns the mean of the used prefix
+ *
+ * @param[in,out] handle Handle to analyse
+ * @return double Arithmetic mean, 0 if the handle is empty
+ */
+double Mean_Average_h(IntArray* handle) {
+    PROFILE_ENTER();
+    Array_Statistics stats;
+    Array_Stats_h(handle, &stats);
+    PROFILE_EXIT(PROBE_MEAN_AVERAGE_H, handle->used);
+    return stats.mean;
+}
+
+/**
+ * @brief Returns the k-th smallest used value
+ *
+ * Reads data[k] directly when the handle is sorted; otherwise runs
+ * introselect on a copy of the used prefix, so the handle is not
+ * modified.
+ *
+ * @param[in] handle Handle to analyse
+ * @param[in] k Zero-based rank among the used elements
+ * @return int The k-th smallest used value, UNUSED_MARKER if k is out of range
+ */
+int Array_Nth_h(const IntArray* handle, int k) {
+    PROFILE_ENTER();
+    int value = UNUSED_MARKER;
+
+    if (k < 0 || k >= handle->used) {
+        /* Out of range, value stays UNUSED_MARKER */
+    }
+    else if (handle->cache.is_sorted) {
+        value = handle->data[k];
+    }
+    else {
+        Arena_Mark mark = Arena_Save(Scratch_Arena());
+        int* scratch = Arena_Alloc(Scratch_Arena(), (size_t)handle->used * sizeof(int)); /**< Copy that introselect may rearrange */
+        if (scratch != NULL) {
+            memcpy(scratch, handle->data, (size_t)handle->used * sizeof(int));
+            value = Select_Nth(scratch, handle->used, k);
+        }
+        Arena_Restore(Scratch_Arena(), mark);
+    }
+    PROFILE_EXIT(PROBE_ARRAY_NTH_H, handle->used);
+    return value;
+}
+
+/**
+ * @brief Returns the median of the used prefix
+ *
+ * O(1) when the handle is sorted, O(n) introselect on a copy otherwise.
+ * Both give the same result as Median_Select().
+ *
+ * @param[in] handle Handle to analyse
+ * @return int Median of the used values, 0 if the handle is empty
+ *
+ * @see Median_Select()
+ */
+int Median_Average_h(const IntArray* handle) {
+    PROFILE_ENTER();
+    int median = 0;
+
+    if (handle->used == 0) {
+        /* Empty, median stays 0 */
+    }
+    else if (handle->cache.is_sorted) {
+        int upper = handle->data[handle->used / 2]; /**< Upper (or only) middle value */
+        median = (handle->used % 2 != 0) ? upper
+            : (int)(((long long)handle->data[handle->used / 2 - 1] + upper) / 2);
+    }
+    else {
+        Arena_Mark mark = Arena_Save(Scratch_Arena());
+        int* scratch = Arena_Alloc(Scratch_Arena(), (size_t)handle->used * sizeof(int)); /**< Copy that introselect may rearrange */
+        if (scratch != NULL) {
+            memcpy(scratch, handle->data, (size_t)handle->used * sizeof(int));
+            median = Median_Select(scratch, handle->used);
+        }
+        Arena_Restore(Scratch_Arena(), mark);
+    }
+    PROFILE_EXIT(PROBE_MEDIAN_AVERAGE_H, handle->used);
+    return median;
+}
+
+/**
+ * @brief Returns the population variance of the used prefix
+ *
+ * @param[in,out] handle Handle to analyse
+ * @return double Variance, 0 if the handle is empty
+ */
+double Variance_h(IntArray* handle) {
+    PROFILE_ENTER();
+    Array_Statistics stats;
+    Array_Stats_h(handle, &stats);
+    PROFILE_EXIT(PROBE_VARIANCE_H, handle->used);
+    return stats.variance;
+}
+
+/**
+ * @brief Returns the standard deviation of the used prefix
+ *
+ * @param[in,out] handle Handle to analyse
+ * @return double Standard deviation, 0 if the handle is empty
+ */
+double Standard_Deviation_h(IntArray* handle) {
+    PROFILE_ENTER();
+    Array_Statistics stats;
+    Array_Stats_h(handle, &stats);
+    PROFILE_EXIT(PROBE_STANDARD_DEVIATION_H, handle->used);
+    return stats.standard_deviation;
+}
@@ -0,0 +1,68 @@
+#ifndef INT_ARRAY_HEADER_H
+#define INT_ARRAY_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+#include "Maths_Operations_Header.h" // include maths header for Array_Statistics
+
+#define INT_ARRAY_MIN_CAPACITY 16 // smallest buffer Int_Array_Reserve() allocates
+
+/**
+ * @brief Statistics remembered between queries on a handle
+ *
+ * Single-element writes through Int_Array_Push() and Int_Array_Set()
+ * update the moments in place; bulk fills drop them and the next query
+ * rescans. Once the prefix is known to be sorted, min, max, median and
+ * any order statistic are read straight from the data.
+ */
+typedef struct Int_Array_Cache {
+    int valid; // non-zero if moments describe the current used prefix
+    int is_sorted; // non-zero if the used prefix is known to be in ascending order
+    Array_Moments moments; // count, sum, min, max and shifted sum of squares of the used prefix
+} Int_Array_Cache;
+
+/**
+ * @brief Dense array handle with an O(1) used count
+ *
+ * Used elements are always packed into data[0, used) and every slot in
+ * data[used, capacity) holds UNUSED_MARKER, so data is also a valid
+ * sentinel array for the (array, capacity) functions.
+ *
+ * A handle made by Int_Array_Init() owns its heap buffer and grows it
+ * geometrically on demand; a handle made by Int_Array_Wrap() borrows the
+ * caller's buffer and moves to a heap buffer the first time it grows.
+ */
+typedef struct IntArray {
+    int* data; // element buffer
+    int used; // number of used elements at the front of data
+    int capacity; // total number of slots in data
+    int owned; // non-zero if data was allocated here and must be freed with Int_Array_Free()
+    Int_Array_Cache cache; // statistics kept up to date by the Int_Array_ and _h functions
+} IntArray;
+
+void Int_Array_Wrap(IntArray* handle, int array[], int capacity); // adapts a sentinel array: compacts it in place and fills the handle
+int Int_Array_Init(IntArray* handle, int capacity); // allocates an empty heap-backed array, returns 0 on success or -1 if out of memory
+int Int_Array_Reserve(IntArray* handle, int capacity); // grows the buffer to at least capacity slots, returns 0 on success or -1
+int Int_Array_Push(IntArray* handle, int value); // appends a used value, growing if full, returns 0 on success or -1 if value is negative or out of memory
+int Int_Array_Set(IntArray* handle, int index, int value); // overwrites a used element, returns 0 on success or -1 if index or value is invalid
+void Int_Array_Invalidate(IntArray* handle); // forgets cached statistics after handle->data was written directly
+void Int_Array_Free(IntArray* handle); // releases a buffer allocated by the handle
+
+// Dense-prefix variants of the WF functions
+void Keyboard_Input_h(IntArray* handle); // WF2 - reads values from the keyboard into the handle
+void Array_Random_h(IntArray* handle, int size, int min, int max); // WF3 - fills the first size slots with random numbers
+void Clear_Array_h(IntArray* handle); // WF4 - clears only the used prefix
+void Sort_Array_h(IntArray* handle); // WF5 - sorts the used prefix, no compaction needed
+void Shuffle_Array_h(IntArray* handle); // WF6 - randomizes the order of the used prefix
+void Print_Used_h(const IntArray* handle); // WF7 - prints the used prefix
+void Print_All_h(const IntArray* handle); // WF8 - prints every slot
+int Find_Min_h(IntArray* handle); // WF9 - minimum used value, UNUSED_MARKER if none, O(1) once cached or sorted
+int Find_Max_h(IntArray* handle); // WF10 - maximum used value, UNUSED_MARKER if none, O(1) once cached or sorted
+int Num_of_Used_Elements_h(const IntArray* handle); // number of used elements in O(1)
+void Array_Stats_h(IntArray* handle, Array_Statistics* stats); // all summary statistics of the used prefix, scanned only if not cached
+double Mean_Average_h(IntArray* handle); // mean of the used prefix
+int Median_Average_h(const IntArray* handle); // median of the used prefix, O(1) if sorted, does not modify the data
+int Array_Nth_h(const IntArray* handle, int k); // k-th smallest used value, UNUSED_MARKER if out of range, O(1) if sorted
+double Variance_h(IntArray* handle); // population variance of the used prefix
+double Standard_Deviation_h(IntArray* handle); // standard deviation of the used prefix
+
+#endif // INT_ARRAY_HEADER_H
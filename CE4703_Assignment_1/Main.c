@@ -11,19 +11,73 @@
 #include <stdio.h>
 #include "Simple_Operations_Header.h"
 #include "Menu_Header.h"
+#include "Parse_Operations_Header.h"
+#include "Int_Array_Header.h"
+#include "Arena_Header.h"
 
  /**
   * @brief Clears the input buffer to prevent infinite loops from invalid input
   *
   * This helper function reads and discards any remaining characters in the input
-  * buffer, including the newline character. This prevents scanf failures from
+  * buffer, including the newline character. This prevents invalid input from
   * affecting subsequent input operations.
   *
   * @note This function handles both EOF conditions and buffer overflow scenarios
   */
 static void clearInputBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
+    Parser_Skip_Line(Parser_Stdin());
+}
+
+/**
+ * @brief Runs menu function 1, 2 or 3 on a heap array of any capacity
+ *
+ * The array is allocated for the run and released afterwards, together
+ * with the scratch memory the kernels used, so even very large
+ * capacities never touch the stack.
+ *
+ * @param[in] function Menu function number, 1 to 3
+ * @param[in] capacity Number of elements in the array
+ * @return int 0 on success, -1 if the array could not be allocated
+ */
+static int runMenuFunction(int function, int capacity) {
+    IntArray array; /**< Heap-backed array for the run */
+
+    if (Int_Array_Init(&array, capacity) != 0) {
+        printf("Not enough memory for %d elements.\n", capacity);
+        return -1;
+    }
+    switch (function) {
+    case 1:
+        MF1(array.data, capacity);
+        break;
+    case 2:
+        MF2(array.data, capacity);
+        break;
+    default:
+        MF3(array.data, capacity);
+        break;
+    }
+    Int_Array_Free(&array);
+    Arena_Free(Scratch_Arena()); /* Return this run's scratch buffers to the system */
+    return 0;
+}
+
+/**
+ * @brief Prompts for one integer on its own line
+ *
+ * @param[in] prompt Text to display
+ * @param[out] value Receives the value entered
+ * @return int 1 if a value was read, 0 on invalid input or end of input
+ */
+static int readValue(const char* prompt, int* value) {
+    int scanned;
+
+    printf("%s", prompt);
+    scanned = Parser_Next(Parser_Stdin(), value);
+    if (scanned != PARSE_END) {
+        clearInputBuffer();
+    }
+    return scanned == PARSE_VALUE;
 }
 
 /**
@@ -37,12 +91,14 @@ static void clearInputBuffer() {
  * - Option 1: Test Menu Function 1 with capacity1 (10 elements)
  * - Option 2: Test Menu Function 2 with capacity2 (20 elements)
  * - Option 3: Test Menu Function 3 with capacity3 (100 elements)
- * - Option 4: Exit the program gracefully
+ * - Option 4: Test Menu Function 4 with streaming input (no capacity limit)
+ * - Option 5: Run Menu Function 1, 2 or 3 with a capacity entered by the user
+ * - Option 6: Exit the program gracefully
  *
  * @return int Program exit status (EXIT_SUCCESS upon normal termination)
  *
- * @note The function uses local array declarations within case blocks to
- *       ensure proper scope and memory management
+ * @note Arrays are allocated on the heap for each run, so capacities far
+ *       beyond the stack size are supported
  * @warning Input validation is performed to prevent buffer overflow and
  *          infinite loops from invalid user input
  */
@@ -56,13 +112,19 @@ int main() {
         printf("1. Test Menu Function 1 (Capacity 10)\n");
         printf("2. Test Menu Function 2 (Capacity 20)\n");
         printf("3. Test Menu Function 3 (Capacity 100)\n");
-        printf("4. Exit\n");
+        printf("4. Test Menu Function 4 (Streaming statistics)\n");
+        printf("5. Run Menu Function 1-3 with a custom capacity\n");
+        printf("6. Exit\n");
         printf("Enter your option: ");
 
         /* Validate user input */
-        if (scanf_s("%d", &option) != 1) {
+        int scanned = Parser_Next(Parser_Stdin(), &option);
+        if (scanned == PARSE_END) {
+            break; /* End of input, nothing more can be selected */
+        }
+        if (scanned != PARSE_VALUE) {
             printf("Invalid option. Please try again.\n");
-            clearInputBuffer(); /* Flush invalid input to prevent infinite loop */
+            clearInputBuffer(); /* Flush the rest of the invalid line */
             option = 0;         /* Reset option to remain in menu */
             continue;
         }
@@ -70,28 +132,37 @@ int main() {
 
         /* Process user selection */
         switch (option) {
-        case 1: {
-            int arr1[capacity1]; /**< Array for Menu Function 1 testing */
-            MF1(arr1, capacity1);
+        case 1:
+            runMenuFunction(1, capacity1);
             break;
-        }
-        case 2: {
-            int arr2[capacity2]; /**< Array for Menu Function 2 testing */
-            MF2(arr2, capacity2);
+        case 2:
+            runMenuFunction(2, capacity2);
             break;
-        }
-        case 3: {
-            int arr3[capacity3]; /**< Array for Menu Function 3 testing */
-            MF3(arr3, capacity3);
+        case 3:
+            runMenuFunction(3, capacity3);
             break;
-        }
         case 4:
+            MF4();
+            clearInputBuffer(); /* Discard the rest of the line that ended the stream */
+            break;
+        case 5: {
+            int function = 0; /**< Menu function to run */
+            int capacity = 0; /**< Capacity chosen by the user */
+            if (!readValue("Menu function (1-3): ", &function) || function < 1 || function > 3
+                || !readValue("Capacity: ", &capacity) || capacity < 1) {
+                printf("Invalid choice. Please try again.\n");
+                break;
+            }
+            runMenuFunction(function, capacity);
+            break;
+        }
+        case 6:
             printf("Exiting program.\n");
             break;
         default:
             printf("Invalid option. Please try again.\n");
         }
-	} while (option != 4); // Continue until user chooses to exit
+	} while (option != 6); // Continue until user chooses to exit
 
 	return EXIT_SUCCESS; // Indicates successful program termination
 }
\ No newline at end of file
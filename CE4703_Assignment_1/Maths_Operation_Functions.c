@@ -9,10 +9,233 @@
 
 #include "Maths_Operations_Header.h" // linking the header definitions
 #include "Main_Header.h" // linking the main header definitions
+#include "Sort_Operations_Header.h" // linking introselect for order statistics
+#include "Simd_Operations_Header.h" // linking the dispatched scan kernels
+#include "Parallel_Header.h" // linking the worker pool for large arrays
+#include "Arena_Header.h" // linking the scratch arena
+#include "Profile_Header.h" // linking the optional profiling probes
+#include "Histogram_Operations_Header.h" // linking the count-table engine for small ranges
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h> // including native c header for math functions
 
+ /**
+  * @brief Computes count, sum, min, max, mean, variance and standard deviation in one pass
+  *
+  * Scans the array once and accumulates every moment needed by the other
+  * statistic functions. The sum is accumulated exactly in a 64-bit integer.
+  * The squared deviations are taken from a shift (the first used element)
+  * rather than from zero, so the two-moment variance formula does not lose
+  * precision to cancellation when the values are large and close together.
+  * The scan itself is done by Moments_Reduce(), which uses SIMD when the
+  * CPU supports it and splits large arrays across threads.
+  *
+  * @param[in] array Array of integers to process
+  * @param[in] capacity Total number of elements in the array
+  * @param[out] stats Structure receiving the statistics of the used elements
+  *
+  * @return void
+  *
+  * @note If there are no used elements, count, sum, mean and variance are 0
+  *       and min and max are UNUSED_MARKER
+  *
+  * @code
+  * int arr[5] = {10, UNUSED, 20, 30, UNUSED};
+  * Array_Statistics stats;
+  * Array_Stats(arr, 5, &stats); // count 3, sum 60, min 10, max 30, mean 20.0
+  * @endcode
+  */
+void Array_Stats(int array[], int capacity, Array_Statistics* stats) {
+    PROFILE_ENTER();
+    Array_Moments moments; /**< Raw sums accumulated by the scan kernels */
+    Moments_Reduce(array, capacity, &moments);
+    Stats_From_Moments(&moments, stats);
+    PROFILE_EXIT(PROBE_ARRAY_STATS, capacity);
+}
+
+/**
+ * @brief Shared state of a parallel moment reduction
+ */
+typedef struct Reduce_Job {
+    const int* array; // array being scanned
+    int count; // number of elements in array
+    int chunk; // elements per task, a multiple of REDUCE_ALIGN
+    Array_Moments* partials; // one result per task
+} Reduce_Job;
+
+/**
+ * @brief Scans a range with the first used element as the shift
+ *
+ * @param[in] array Array of integers to scan
+ * @param[in] count Number of elements to scan
+ * @param[out] moments Sums of the used elements in the range
+ */
+static void Scan_Range(const int array[], int count, Array_Moments* moments) {
+    int i = 0;
+
+    /* Skip leading unused elements and take the first used one as the shift */
+    while (i < count && !IS_USED(array[i])) {
+        i++;
+    }
+    moments->shift = (i < count) ? array[i] : 0;
+    Moments_Scan(array + i, count - i, moments); /**< SIMD or scalar kernel chosen at startup */
+}
+
+/**
+ * @brief Parallel task: scans one chunk of the array
+ */
+static void Reduce_Chunk_Task(void* context, int task) {
+    Reduce_Job* job = context;
+    long long start = (long long)task * job->chunk;
+    long long end = start + job->chunk;
+
+    if (end > job->count) {
+        end = job->count;
+    }
+    Scan_Range(job->array + start, (int)(end - start), &job->partials[task]);
+}
+
+/**
+ * @brief Accumulates the moments of the used elements, in parallel for large arrays
+ *
+ * Arrays shorter than PARALLEL_STATS_THRESHOLD are scanned on the calling
+ * thread. Larger arrays are cut into chunks whose length is a multiple of
+ * a cache line, the chunks are scanned on the worker pool, and the partial
+ * results are combined with Moments_Merge().
+ *
+ * @param[in] array Array of integers to scan
+ * @param[in] count Number of elements to scan
+ * @param[out] moments Sums of the used elements, shifted by the first used element
+ *
+ * @return void
+ */
+void Moments_Reduce(const int array[], int count, Array_Moments* moments) {
+    if (count < PARALLEL_STATS_THRESHOLD) {
+        Scan_Range(array, count, moments);
+        return;
+    }
+
+    int threads = Parallel_Thread_Count();
+    if (threads <= 1) {
+        Scan_Range(array, count, moments);
+        return;
+    }
+
+    int tasks = threads * REDUCE_TASKS_PER_THREAD; /**< A few tasks per thread to even out the load */
+    int chunk = (int)(((long long)count + tasks - 1) / tasks);
+    chunk = (chunk + REDUCE_ALIGN - 1) / REDUCE_ALIGN * REDUCE_ALIGN; /**< Whole cache lines per chunk */
+    tasks = (int)(((long long)count + chunk - 1) / chunk);
+
+    Arena* arena = Scratch_Arena();
+    Arena_Mark mark = Arena_Save(arena);
+    Array_Moments* partials = Arena_Alloc(arena, (size_t)tasks * sizeof(Array_Moments));
+    if (partials == NULL) {
+        Scan_Range(array, count, moments); /**< Not enough memory for the partials, scan serially */
+        return;
+    }
+
+    Reduce_Job job = { array, count, chunk, partials };
+    Simd_Level(); /**< Resolve the scan kernel here, not on several workers at once */
+    Parallel_Run(tasks, Reduce_Chunk_Task, &job);
+
+    *moments = partials[0];
+    for (int t = 1; t < tasks; t++) {
+        Moments_Merge(moments, &partials[t]);
+    }
+    Arena_Restore(arena, mark);
+}
+
+/**
+ * @brief Combines the moments of two disjoint sets of elements
+ *
+ * Uses the pairwise update of Chan et al.: each side's sum of squared
+ * deviations from its own mean (M2) is recovered, the two are added
+ * together with a correction for the distance between the means, and the
+ * result is stored back in shifted form using into's shift.
+ *
+ * @param[in,out] into Moments of the first set, replaced by the combined moments
+ * @param[in] from Moments of the second set
+ *
+ * @return void
+ */
+void Moments_Merge(Array_Moments* into, const Array_Moments* from) {
+    if (from->count == 0) {
+        return;
+    }
+    if (into->count == 0) {
+        *into = *from;
+        return;
+    }
+
+    double count_a = into->count;
+    double count_b = from->count;
+    double deviation_a = (double)(into->sum - (long long)into->count * into->shift); /**< Sum of deviations from own shift */
+    double deviation_b = (double)(from->sum - (long long)from->count * from->shift);
+    double m2_a = into->sum_squares - deviation_a * deviation_a / count_a; /**< Squared deviations from own mean */
+    double m2_b = from->sum_squares - deviation_b * deviation_b / count_b;
+    double mean_a = (double)into->sum / count_a;
+    double mean_b = (double)from->sum / count_b;
+    double delta = mean_b - mean_a;
+    double count = count_a + count_b;
+    double m2 = m2_a + m2_b + delta * delta * count_a * count_b / count;
+
+    into->count += from->count;
+    into->sum += from->sum;
+    if (from->min < into->min) {
+        into->min = from->min;
+    }
+    if (from->max > into->max) {
+        into->max = from->max;
+    }
+
+    /* Express M2 relative to into's shift again */
+    double offset = (double)into->sum / count - into->shift;
+    into->sum_squares = m2 + count * offset * offset;
+}
+
+/**
+ * @brief Converts raw moment sums into summary statistics
+ *
+ * Derives mean, population variance and standard deviation from the
+ * count, exact sum and shifted sum of squares accumulated by a scan
+ * kernel. Shared by every code path that accumulates Array_Moments.
+ *
+ * @param[in] moments Sums accumulated over the used elements
+ * @param[out] stats Structure receiving the statistics
+ *
+ * @return void
+ *
+ * @note If count is 0, min and max are set to UNUSED_MARKER and the rest to 0
+ */
+void Stats_From_Moments(const Array_Moments* moments, Array_Statistics* stats) {
+    int count = moments->count; /**< Number of used elements */
+
+    stats->count = count;
+    stats->sum = moments->sum;
+
+    /* Handle case with no used elements to prevent division by zero */
+    if (count == 0) {
+        stats->min = UNUSED_MARKER;
+        stats->max = UNUSED_MARKER;
+        stats->mean = 0.0;
+        stats->variance = 0.0;
+        stats->standard_deviation = 0.0;
+        return;
+    }
+
+    double shifted_sum = (double)(moments->sum - (long long)count * moments->shift); /**< Sum of deviations from the shift */
+    double variance = (moments->sum_squares - shifted_sum * shifted_sum / count) / count; /**< Population variance */
+    if (variance < 0.0) {
+        variance = 0.0; /**< Guard against rounding just below zero */
+    }
+
+    stats->min = moments->min;
+    stats->max = moments->max;
+    stats->mean = (double)moments->sum / count;
+    stats->variance = variance;
+    stats->standard_deviation = sqrt(variance);
+}
+
  /**
   * @brief Calculates the arithmetic mean of used elements in the array
   *
@@ -24,7 +247,7 @@
   * @param[in] capacity Total number of elements in the array
   * @return double Arithmetic mean of used elements, 0 if no used elements
   *
-  * @note Uses IS_USED macro to determine which elements contribute to calculation
+  * @note Reads the mean from Array_Stats()
   *
   * @code
   * int arr[5] = {10, UNUSED, 20, 30, UNUSED};
@@ -32,60 +255,294 @@
   * @endcode
   */
 double Mean_Average(int array[], int capacity) {
-    double sum = 0.0; /**< Accumulator for sum of used elements */
-    double count = 0.0; /**< Counter for number of used elements */
+    PROFILE_ENTER();
+    Array_Statistics stats; /**< Statistics of the used elements */
+    Array_Stats(array, capacity, &stats);
+    PROFILE_EXIT(PROBE_MEAN_AVERAGE, capacity);
+    return stats.mean; /**< Return computed average value */
+}
+
+/**
+ * @brief Copies the used elements of an array into a dense scratch buffer
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @param[out] count Number of used elements copied
+ * @return int* Buffer in the scratch arena holding the used elements, NULL if there are none or allocation fails
+ *
+ * @note The caller releases the buffer by restoring a scratch arena mark
+ *       taken before the call
+ */
+static int* Copy_Used(int array[], int capacity, int* count) {
+    int* scratch = Arena_Alloc(Scratch_Arena(), (size_t)capacity * sizeof(int)); /**< Dense copy of used elements */
+    int used = 0;
 
+    if (scratch == NULL) {
+        *count = 0;
+        return NULL;
+    }
     for (int i = 0; i < capacity; i++) {
         if (IS_USED(array[i])) {
-            sum += array[i]; /**< Add element value to running sum */
-            count++; /**< Increment used element counter */
+            scratch[used++] = array[i];
         }
     }
+    *count = used;
+    return (used > 0) ? scratch : NULL;
+}
 
-    /* Handle case with no used elements to prevent division by zero */
-    if (count == 0) {
-        return 0;
+/**
+ * @brief Counts the used elements into a histogram when their range is small
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @param[out] histogram Histogram filled on success
+ * @return int Non-zero if the histogram was built, zero if the caller should fall back to selection
+ *
+ * @note The caller releases the table by restoring a scratch arena mark
+ *       taken before the call
+ * @see Histogram_Fits()
+ */
+static int Used_Histogram(int array[], int capacity, Histogram* histogram) {
+    int min, max;
+    int count = Histogram_Bounds(array, capacity, &min, &max); /**< Number of used elements */
+
+    return Histogram_Fits(min, max, count) && Histogram_Build(histogram, array, capacity, min, max) == 0;
+}
+
+/**
+ * @brief Returns the k-th smallest used element of the array
+ *
+ * Copies the used elements into a scratch buffer and runs introselect
+ * (see Select_Nth()) on the copy, so the input array is left unchanged
+ * and does not need to be sorted. When the values span a small range the
+ * rank is read from a count table instead (see Histogram_Fits()).
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @param[in] k Zero-based rank among the used elements (0 is the minimum)
+ * @return int The k-th smallest used value, UNUSED_MARKER if k is out of range
+ *
+ * @note O(n) time and O(n) scratch memory
+ *
+ * @code
+ * int arr[6] = {40, UNUSED, 10, 30, UNUSED, 20};
+ * int second = Array_Nth(arr, 6, 1); // Returns 20
+ * @endcode
+ */
+int Array_Nth(int array[], int capacity, int k) {
+    PROFILE_ENTER();
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    Histogram histogram; /**< Count table, used when the value range is small */
+    int value = UNUSED_MARKER;
+
+    if (Used_Histogram(array, capacity, &histogram)) {
+        value = Histogram_Nth(&histogram, k);
     }
+    else {
+        int count = 0; /**< Number of used elements */
+        int* scratch = Copy_Used(array, capacity, &count); /**< Copy that introselect may rearrange */
+        if (scratch != NULL && k >= 0 && k < count) {
+            value = Select_Nth(scratch, count, k);
+        }
+    }
+    Arena_Restore(Scratch_Arena(), mark);
+    PROFILE_EXIT(PROBE_ARRAY_NTH, capacity);
+    return value;
+}
 
-    double average = sum / count; /**< Calculate mean average */
-    return average; /**< Return computed average value */
+/**
+ * @brief Returns the median of a dense buffer of values
+ *
+ * Selects the upper middle element with introselect. For an even count
+ * the lower middle is the largest element left of it, and the result is
+ * the average of the two (rounded toward zero).
+ *
+ * @param[in,out] data Buffer of used values, rearranged by the selection
+ * @param[in] count Number of elements in data, must be at least 1
+ * @return int Median value
+ *
+ * @note O(n) time
+ */
+int Median_Select(int data[], int count) {
+    int upper = Select_Nth(data, count, count / 2); /**< Upper (or only) middle value */
+
+    if (count % 2 != 0) {
+        return upper;
+    }
+
+    /* Everything before the selected index is <= upper, so the lower middle is its maximum */
+    int lower = data[0];
+    for (int i = 1; i < count / 2; i++) {
+        if (data[i] > lower) {
+            lower = data[i];
+        }
+    }
+    return (int)(((long long)lower + upper) / 2); /**< Average of two middle values */
 }
 
 /**
  * @brief Calculates the median value of used elements in the array
  *
- * Determines the median value by finding the middle element(s) in what
- * should be a sorted array. For even-sized arrays, returns the average
- * of the two middle values.
+ * Selects the middle used element with introselect on a scratch copy, so
+ * the array does not have to be sorted and unused elements are ignored.
+ * For an even number of used elements, returns the average of the two
+ * middle values (rounded toward zero). When the values span a small
+ * range the median is read from a count table instead, which needs no
+ * copy of the data.
  *
- * @param[in] array Array of integers to process (should be sorted)
+ * @param[in] array Array of integers to process
  * @param[in] capacity Total number of elements in the array
- * @return int Median value of used elements
+ * @return int Median value of used elements, 0 if no used elements
  *
- * @note Assumes the input array is sorted in ascending order
+ * @note O(n) time, O(n + range) on the histogram path; the input array is not modified
  *
- * @todo Fix implementation to properly handle used elements and sorting
+ * @code
+ * int arr[5] = {30, UNUSED, 10, 40, 20};
+ * int median = Median_Average(arr, 5); // Returns (20 + 30) / 2 = 25
+ * @endcode
  */
 int Median_Average(int array[], int capacity) {
-    int median = 0; /**< Variable to store median result */
+    PROFILE_ENTER();
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    Histogram histogram; /**< Count table, used when the value range is small */
+    int median = 0; /**< Variable to store median result, 0 if no used elements */
 
-    for (int i = 0; i < capacity; i++) {
-        if (IS_USED(array[i])) {
-            /* Check if total capacity is even */
-            if (capacity % 2 == 0) {
-                int mid1 = capacity / 2 - 1; /**< First middle index */
-                int mid2 = capacity / 2; /**< Second middle index */
-                int median = (array[mid1] + array[mid2]) / 2; /**< Average of two middle values */
-                return median;
+    if (Used_Histogram(array, capacity, &histogram)) {
+        median = Histogram_Median(&histogram);
+    }
+    else {
+        int count = 0; /**< Number of used elements */
+        int* scratch = Copy_Used(array, capacity, &count); /**< Copy that introselect may rearrange */
+        if (scratch != NULL) {
+            median = Median_Select(scratch, count);
+        }
+    }
+    Arena_Restore(Scratch_Arena(), mark);
+    PROFILE_EXIT(PROBE_MEDIAN_AVERAGE, capacity);
+    return median;
+}
+
+/**
+ * @brief Returns a percentile of the used elements by the nearest-rank method
+ *
+ * The result is the smallest used value with at least percentile% of the
+ * used values at or below it. Uses a count table for small value ranges
+ * and introselect on a scratch copy otherwise.
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @param[in] percentile Percentile to return, clamped to [0, 100]
+ * @return int Percentile value, UNUSED_MARKER if no used elements
+ *
+ * @code
+ * int arr[5] = {30, UNUSED, 10, 40, 20};
+ * int p75 = Array_Percentile(arr, 5, 75.0); // Returns 30
+ * @endcode
+ */
+int Array_Percentile(int array[], int capacity, double percentile) {
+    PROFILE_ENTER();
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    Histogram histogram; /**< Count table, used when the value range is small */
+    int value = UNUSED_MARKER;
+
+    if (Used_Histogram(array, capacity, &histogram)) {
+        value = Histogram_Percentile(&histogram, percentile);
+    }
+    else {
+        int count = 0; /**< Number of used elements */
+        int* scratch = Copy_Used(array, capacity, &count); /**< Copy that introselect may rearrange */
+        if (scratch != NULL) {
+            double rank = ceil(percentile / 100.0 * count); /**< One-based nearest rank */
+            int k = (rank < 1.0) ? 0 : (rank > count) ? count - 1 : (int)rank - 1;
+            value = Select_Nth(scratch, count, k);
+        }
+    }
+    Arena_Restore(Scratch_Arena(), mark);
+    PROFILE_EXIT(PROBE_ARRAY_PERCENTILE, capacity);
+    return value;
+}
+
+/**
+ * @brief Returns the most frequent used element
+ *
+ * Reads the mode from a count table when the value range is small,
+ * otherwise sorts a scratch copy and finds the longest run.
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @param[out] frequency Occurrences of the mode, may be NULL
+ * @return int Most frequent used value (the smallest one on ties), UNUSED_MARKER if no used elements
+ *
+ * @code
+ * int arr[6] = {20, UNUSED, 10, 20, 30, 10};
+ * int mode = Mode_Value(arr, 6, NULL); // Returns 10
+ * @endcode
+ */
+int Mode_Value(int array[], int capacity, int* frequency) {
+    PROFILE_ENTER();
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    Histogram histogram; /**< Count table, used when the value range is small */
+    int mode = UNUSED_MARKER;
+    int best = 0; /**< Occurrences of the mode */
+
+    if (Used_Histogram(array, capacity, &histogram)) {
+        mode = Histogram_Mode(&histogram, &best);
+    }
+    else {
+        int count = 0; /**< Number of used elements */
+        int* scratch = Copy_Used(array, capacity, &count); /**< Copy that is sorted into runs */
+        if (scratch != NULL) {
+            Sort_Dense(scratch, count);
+            for (int start = 0, end; start < count; start = end) {
+                for (end = start + 1; end < count && scratch[end] == scratch[start]; end++) {
+                }
+                if (end - start > best) {
+                    best = end - start;
+                    mode = scratch[start];
+                }
             }
-            /* Handle odd-sized arrays */
-            else {
-                int mid = (capacity + 1) / 2; /**< Middle index for odd count */
-                return array[mid]; /**< Direct middle value */
+        }
+    }
+    Arena_Restore(Scratch_Arena(), mark);
+    if (frequency != NULL) {
+        *frequency = best;
+    }
+    PROFILE_EXIT(PROBE_MODE_VALUE, capacity);
+    return mode;
+}
+
+/**
+ * @brief Counts the different values among the used elements
+ *
+ * Counts the non-empty slots of a count table when the value range is
+ * small, otherwise sorts a scratch copy and counts the runs.
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @return int Number of distinct used values, 0 if no used elements
+ */
+int Distinct_Count(int array[], int capacity) {
+    PROFILE_ENTER();
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    Histogram histogram; /**< Count table, used when the value range is small */
+    int distinct = 0;
+
+    if (Used_Histogram(array, capacity, &histogram)) {
+        distinct = Histogram_Distinct(&histogram);
+    }
+    else {
+        int count = 0; /**< Number of used elements */
+        int* scratch = Copy_Used(array, capacity, &count); /**< Copy that is sorted into runs */
+        if (scratch != NULL) {
+            Sort_Dense(scratch, count);
+            for (int i = 0; i < count; i++) {
+                distinct += (i == 0 || scratch[i] != scratch[i - 1]);
             }
         }
     }
-    return median; /**< Return median (default 0 if no used elements) */
+    Arena_Restore(Scratch_Arena(), mark);
+    PROFILE_EXIT(PROBE_DISTINCT_COUNT, capacity);
+    return distinct;
 }
 
 /**
@@ -96,27 +553,16 @@ int Median_Average(int array[], int capacity) {
  *
  * @param[in] array Array of integers to process
  * @param[in] capacity Total number of elements in the array
- * @return double Variance of used elements
- *
- * @note Uses Mean_Average() function to obtain the mean value
+ * @return double Variance of used elements, 0 if no used elements
  *
- * @bug Variance calculation logic needs review and correction
+ * @note Reads the variance from Array_Stats()
  */
 double Variance(int array[], int capacity) {
-    double count = 0; /**< Counter for number of used elements */
-    double sum = 0.0; /**< Accumulator for sum of used elements */
-    double average = Mean_Average(array, capacity); /**< Mean value from Mean_Average() */
-
-    for (int i = 0; i < capacity; i++) {
-        if (IS_USED(array[i])) {
-            count += 1.0; /**< Increment used element counter */
-            sum += array[i]; /**< Add to sum of elements */
-        }
-    }
-
-    /* Calculate variance using population formula */
-    double variance = ((sum) * (sum)) / (count); /**< Variance calculation */
-    return variance; /**< Return computed variance */
+    PROFILE_ENTER();
+    Array_Statistics stats; /**< Statistics of the used elements */
+    Array_Stats(array, capacity, &stats);
+    PROFILE_EXIT(PROBE_VARIANCE, capacity);
+    return stats.variance; /**< Return computed variance */
 }
 
 /**
@@ -130,7 +576,7 @@ double Variance(int array[], int capacity) {
  * @param[in] capacity Total number of elements in the array
  * @return double Standard deviation of used elements
  *
- * @note Uses Variance() function and sqrt() from math.h
+ * @note Reads the standard deviation from Array_Stats()
  *
  * @code
  * int arr[4] = {10, 20, 30, 40};
@@ -138,8 +584,9 @@ double Variance(int array[], int capacity) {
  * @endcode
  */
 double Standard_Deviation(int array[], int capacity) {
-    double variance = Variance(array, capacity); /**< Get variance from Variance() */
-    double standard_deviation = sqrt(variance); /**< Calculate square root of variance */
-    return standard_deviation; /**< Return standard deviation */
-}
-
+    PROFILE_ENTER();
+    Array_Statistics stats; /**< Statistics of the used elements */
+    Array_Stats(array, capacity, &stats);
+    PROFILE_EXIT(PROBE_STANDARD_DEVIATION, capacity);
+    return stats.standard_deviation; /**< Return standard deviation */
+}
\ No newline at end of file
@@ -1,9 +1,55 @@
 #ifndef MATHS_OPERATIONS_HEADER_H // include guard
 #define MATHS_OPERATIONS_HEADER_H
 
+#include "Main_Header.h" // include main header for macros
+
+#define PARALLEL_STATS_THRESHOLD (1 << 20) // arrays this large have their statistics computed on all cores
+#define REDUCE_TASKS_PER_THREAD 4 // chunks per thread in a parallel reduction
+#define REDUCE_ALIGN 16 // chunk lengths are a multiple of this many ints (one 64-byte cache line)
+
+/**
+ * @brief Summary statistics of the used elements of an array
+ *
+ * Filled in a single pass by Array_Stats(). The other statistic functions
+ * read their result from this structure rather than rescanning the array.
+ */
+typedef struct Array_Statistics {
+    int count; // number of used elements
+    long long sum; // exact sum of used elements
+    int min; // smallest used element, UNUSED_MARKER if none
+    int max; // largest used element, UNUSED_MARKER if none
+    double mean; // arithmetic mean, 0 if no used elements
+    double variance; // population variance, 0 if no used elements
+    double standard_deviation; // square root of the variance
+} Array_Statistics;
+
+/**
+ * @brief Raw sums accumulated by a scan over the used elements
+ *
+ * The squared deviations are taken from shift rather than from zero to
+ * keep the variance accurate; see Stats_From_Moments().
+ */
+typedef struct Array_Moments {
+    int count; // number of used elements
+    long long sum; // exact sum of used elements
+    int min; // smallest used element, INT_MAX if none
+    int max; // largest used element, INT_MIN if none
+    int shift; // reference value for the squared deviations (input to the scan)
+    double sum_squares; // sum of (value - shift)^2 over used elements
+} Array_Moments;
+
+void Array_Stats(int array[], int capacity, Array_Statistics* stats); // Computes all summary statistics of the used elements in one pass
+void Stats_From_Moments(const Array_Moments* moments, Array_Statistics* stats); // Derives mean, variance and standard deviation from raw moment sums
+void Moments_Reduce(const int array[], int count, Array_Moments* moments); // Accumulates moments of used elements, using all cores for large arrays
+void Moments_Merge(Array_Moments* into, const Array_Moments* from); // Combines the moments of two disjoint sets of elements
 double Mean_Average(int array[], int capacity); // Returns the average of the used elements in the array
-int Median_Average(int array[], int capacity); // Returns the median values 
+int Median_Average(int array[], int capacity); // Returns the median of the used elements, the array does not need to be sorted
+int Median_Select(int data[], int count); // Returns the median of a dense buffer of used values, rearranging it
+int Array_Nth(int array[], int capacity, int k); // Returns the k-th smallest used element (0-based) without sorting the array
+int Array_Percentile(int array[], int capacity, double percentile); // Returns the nearest-rank percentile (0 to 100) of the used elements
+int Mode_Value(int array[], int capacity, int* frequency); // Returns the most frequent used element and, if frequency is not NULL, its count
+int Distinct_Count(int array[], int capacity); // Returns the number of different used values
 double Variance(int array[], int capacity); // Returns the variance of the used elements in the array
 double Standard_Deviation(int array[], int capacity); // Returns the standard deviation of the used elements in the array     
 
-#endif // MATHS_OPERATIONS_HEADER_H
\ No newline at end of file
+#endif // MATHS_OPERATIONS_HEADER_H
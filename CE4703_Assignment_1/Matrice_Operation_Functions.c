@@ -10,6 +10,10 @@
 #include "Matrice_Operations_Header.h"
 #include "Main_Header.h" // linking the main header definitions
 #include "Simple_Operations_Header.h" // linking the simple operations header definitions
+#include "Sort_Operations_Header.h" // linking the sort engine
+#include "Random_Engine_Header.h" // linking the random number engine
+#include "Parallel_Header.h" // linking the thread helper for large shuffles
+#include "Profile_Header.h" // linking the optional profiling probes
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -32,6 +36,7 @@
   * @endcode
   */
 void Clear_Array(int array[], int capacity) {
+    PROFILE_ENTER();
     /**
      * @brief Iterate through all array elements and set to UNUSED_MARKER
      *
@@ -41,76 +46,228 @@ void Clear_Array(int array[], int capacity) {
     for (int i = 0; i < capacity; i++) {
         array[i] = UNUSED_MARKER; /**< Set current element to unused state */
     }
+    PROFILE_EXIT(PROBE_CLEAR_ARRAY, capacity);
 }
 
 /**
- * @brief Sorts used elements in ascending order using bubble sort algorithm
+ * @brief Sorts used elements in ascending order and packs them at the front
  *
- * This function performs an in-place sort of the array, but only considers elements
- * marked as USED. The sorting preserves the relative positions of unused elements
- * while arranging used elements in ascending order.
+ * Moves every used element into a dense prefix (see Compact_Used()) and
+ * sorts that prefix with Sort_Dense(), leaving UNUSED_MARKER in all slots
+ * after it. Large inputs are sorted with an O(n) LSD radix sort; small
+ * inputs, or inputs for which no scratch buffer can be allocated, use an
+ * O(n log n) introsort.
  *
  * @param[in,out] array Array to be sorted
  * @param[in] capacity Total number of elements in the array
  *
  * @return void
  *
- * @note Uses bubble sort algorithm with O(n) time complexity
- * @note Only compares and swaps elements that are both marked as USED
+ * @note The choice between radix sort and introsort is made by RADIX_SORT_THRESHOLD
  *
  * @code
  * int arr[5] = {5, UNUSED, 3, 1, UNUSED};
- * Sort_Array(arr, 5); // Result: {1, UNUSED, 3, 5, UNUSED}
+ * Sort_Array(arr, 5); // Result: {1, 3, 5, UNUSED, UNUSED}
  * @endcode
  */
 void Sort_Array(int array[], int capacity) {
-    int i, j, temp; /**< Loop counters and temporary swap variable */
+    PROFILE_ENTER();
+    int used = Compact_Used(array, capacity); /**< Number of used elements in the dense prefix */
+    Sort_Dense(array, used);
+    PROFILE_EXIT(PROBE_SORT_ARRAY, capacity);
+}
 
-    /**
-     * @brief Outer loop for bubble sort passes
-     *
-     * Performs capacity-1 passes through the array to ensure
-     * complete sorting of all used elements.
-     */
-    for (i = 0; i < capacity - 1; i++) {
-        /**
-         * @brief Inner loop for element comparisons
-         *
-         * Compares adjacent elements and swaps them if they are both used
-         * and out of order. The range decreases with each outer loop iteration
-         * as the largest elements bubble to their correct positions.
-         */
-        for (j = 0; j < capacity - i - 1; j++) {
-            /**
-             * @brief Condition for swapping elements
-             *
-             * Checks if both current and next elements are used AND
-             * if the current element is greater than the next element,
-             * indicating they need to be swapped for ascending order.
-             */
-            if (IS_USED(array[j]) && IS_USED(array[j + 1]) && array[j] > array[j + 1]) {
-                temp = array[j]; /**< Store current element temporarily */
-                array[j] = array[j + 1]; /**< Move next element to current position */
-                array[j + 1] = temp; /**< Complete the swap */
+/**
+ * @brief Shared state of a parallel merge shuffle
+ */
+typedef struct Shuffle_Job {
+    int* array; // array being shuffled
+    int capacity; // number of elements in array
+    uint64_t seed; // base seed, every task derives its own generator from it
+    int run_blocks; // blocks per merged run in the current round
+} Shuffle_Job;
+
+/**
+ * @brief Returns the first index of a shuffle block
+ *
+ * @param[in] job Shuffle being run
+ * @param[in] block Block number, 0 to SHUFFLE_BLOCKS inclusive
+ * @return int Index of the first element of the block
+ */
+static int Block_Start(const Shuffle_Job* job, int block) {
+    return (int)((long long)job->capacity * block / SHUFFLE_BLOCKS);
+}
+
+/**
+ * @brief Seeds the generator of one task so results do not depend on thread timing
+ *
+ * @param[out] rng Generator to seed
+ * @param[in] seed Base seed of the shuffle
+ * @param[in] stream Unique number of the task across all rounds
+ */
+static void Seed_Stream(Rng_State* rng, uint64_t seed, int stream) {
+    Rng_Seed(rng, seed ^ ((uint64_t)(stream + 1) * 0xD1B54A32D192ED03ULL));
+}
+
+/**
+ * @brief Uniformly permutes an array with the Fisher-Yates algorithm
+ *
+ * @param[in,out] array Array to shuffle
+ * @param[in] count Number of elements
+ * @param[in,out] rng Generator to draw from
+ */
+static void Fisher_Yates(int array[], int count, Rng_State* rng) {
+    for (int i = count - 1; i > 0; i--) {
+        int j = (int)Rng_Bounded(rng, (uint32_t)i + 1); /**< Random index in [0, i] */
+        int temp = array[i];
+        array[i] = array[j];
+        array[j] = temp;
+    }
+}
+
+/**
+ * @brief Merges two independently shuffled runs into one uniform shuffle
+ *
+ * MergeShuffle merge step: a coin flip decides whether the next element
+ * comes from the first or the second run. When one run is exhausted the
+ * remaining positions are placed with Fisher-Yates insertions, which
+ * corrects the distribution so the result is a uniform permutation.
+ *
+ * @param[in,out] array Runs [0, split) and [split, count), each already shuffled
+ * @param[in] split Length of the first run
+ * @param[in] count Total length
+ * @param[in,out] rng Generator to draw from
+ */
+static void Merge_Shuffled(int array[], int split, int count, Rng_State* rng) {
+    int i = 0; /**< Next output position */
+    int j = split; /**< Next unconsumed element of the second run */
+    uint64_t bits = 0; /**< Buffered coin flips */
+    int bits_left = 0;
+
+    for (;;) {
+        if (bits_left == 0) {
+            bits = Rng_Next(rng);
+            bits_left = 64;
+        }
+        int take_second = (int)(bits & 1);
+        bits >>= 1;
+        bits_left--;
+
+        if (take_second) {
+            if (j == count) {
+                break;
             }
+            int temp = array[i];
+            array[i] = array[j];
+            array[j] = temp;
+            j++;
+        }
+        else if (i == j) {
+            break;
         }
+        i++;
+    }
+
+    for (; i < count; i++) {
+        int p = (int)Rng_Bounded(rng, (uint32_t)i + 1); /**< Random index in [0, i] */
+        int temp = array[i];
+        array[i] = array[p];
+        array[p] = temp;
     }
 }
 
 /**
- * @brief Randomly shuffles used elements while maintaining unused elements
+ * @brief Parallel task: Fisher-Yates shuffle of one block
+ */
+static void Shuffle_Block_Task(void* context, int block) {
+    Shuffle_Job* job = context;
+    Rng_State rng;
+    int start = Block_Start(job, block);
+
+    Seed_Stream(&rng, job->seed, block);
+    Fisher_Yates(job->array + start, Block_Start(job, block + 1) - start, &rng);
+}
+
+/**
+ * @brief Parallel task: merges two neighbouring shuffled runs
+ */
+static void Merge_Runs_Task(void* context, int run) {
+    Shuffle_Job* job = context;
+    Rng_State rng;
+    int first = run * job->run_blocks;
+    int start = Block_Start(job, first);
+    int split = Block_Start(job, first + job->run_blocks / 2);
+    int end = Block_Start(job, first + job->run_blocks);
+
+    Seed_Stream(&rng, job->seed, job->run_blocks * SHUFFLE_BLOCKS + run); /**< Unique per round and run */
+    Merge_Shuffled(job->array + start, split - start, end - start, &rng);
+}
+
+/**
+ * @brief Shuffles a large array on all cores with MergeShuffle
+ *
+ * The array is cut into SHUFFLE_BLOCKS blocks that are shuffled in
+ * parallel, then neighbouring runs are merged pairwise, in parallel, until
+ * one run remains. The block count is fixed, so the result depends only
+ * on the seed, not on the number of threads.
+ *
+ * @param[in,out] array Array to shuffle
+ * @param[in] capacity Number of elements
+ * @param[in] seed Base seed
+ */
+static void Merge_Shuffle(int array[], int capacity, uint64_t seed) {
+    Shuffle_Job job = { array, capacity, seed, 1 };
+
+    Parallel_Run(SHUFFLE_BLOCKS, Shuffle_Block_Task, &job);
+    for (job.run_blocks = 2; job.run_blocks <= SHUFFLE_BLOCKS; job.run_blocks *= 2) {
+        Parallel_Run(SHUFFLE_BLOCKS / job.run_blocks, Merge_Runs_Task, &job);
+    }
+}
+
+/**
+ * @brief Randomly shuffles an array into a reproducible uniform permutation
+ *
+ * Every slot takes part, used or not. The same seed and capacity always
+ * give the same permutation. Arrays of at least PARALLEL_SHUFFLE_THRESHOLD
+ * elements are shuffled on all cores with MergeShuffle; smaller arrays use
+ * a single Fisher-Yates pass.
+ *
+ * @param[in,out] array Array to be shuffled
+ * @param[in] capacity Total number of elements in the array
+ * @param[in] seed Seed of the permutation
  *
- * This function performs a random shuffle of the array elements by swapping
- * random positions. The shuffling affects all elements regardless of their
- * used/unused status, but the random nature may help redistribute used elements.
+ * @return void
+ *
+ * @note O(n) work in both modes
+ */
+void Shuffle_Array_Seeded(int array[], int capacity, uint64_t seed) {
+    PROFILE_ENTER();
+    if (capacity >= PARALLEL_SHUFFLE_THRESHOLD) {
+        Merge_Shuffle(array, capacity, seed);
+        PROFILE_EXIT(PROBE_SHUFFLE_ARRAY, capacity);
+        return;
+    }
+
+    Rng_State rng; /**< Generator for this shuffle only */
+    Rng_Seed(&rng, seed);
+    Fisher_Yates(array, capacity, &rng);
+    PROFILE_EXIT(PROBE_SHUFFLE_ARRAY, capacity);
+}
+
+/**
+ * @brief Randomly shuffles the array into a uniform permutation
+ *
+ * Performs an O(n) Fisher-Yates shuffle driven by the shared generator,
+ * so every ordering is equally likely. Unused elements are shuffled along
+ * with used ones. Large arrays are shuffled in parallel, see
+ * Shuffle_Array_Seeded().
  *
  * @param[in,out] array Array to be shuffled
  * @param[in] capacity Total number of elements in the array
  *
  * @return void
  *
- * @note Uses Fisher-Yates inspired shuffling with random swap operations
- * @note The number of swaps is determined by a random value between 1 and capacity
+ * @note Call Random_Seed() first, or use Shuffle_Array_Seeded(), to reproduce a run
  *
  * @code
  * int arr[5] = {1, 2, 3, UNUSED, 4};
@@ -118,33 +275,5 @@ void Sort_Array(int array[], int capacity) {
  * @endcode
  */
 void Shuffle_Array(int array[], int capacity) {
-    /**
-     * @brief Determine number of random swaps to perform
-     *
-     * Generates a random number between 1 and capacity to determine
-     * how many swap operations will be performed during shuffling.
-     */
-    int random_size = Random_int(1, capacity);
-
-    /**
-     * @brief Perform random swap operations
-     *
-     * Executes a series of random swaps where two random indices
-     * are selected and their elements are exchanged. This creates
-     * a randomized permutation of the array elements.
-     */
-    for (int i = 0; i < random_size; i++) {
-        int rand_index1 = Random_int(0, capacity - 1); /**< First random index */
-        int rand_index2 = Random_int(0, capacity - 1); /**< Second random index */
-
-        /**
-         * @brief Swap elements at random indices
-         *
-         * Standard three-variable swap operation to exchange
-         * elements between two randomly selected positions.
-         */
-        int temp = array[rand_index1];
-        array[rand_index1] = array[rand_index2];
-        array[rand_index2] = temp;
-    }
-}
\ No newline at end of file
+    Shuffle_Array_Seeded(array, capacity, Rng_Next(Rng_Default()));
+}
@@ -1,8 +1,14 @@
 #ifndef MATRICE_OPERATION_HEADER_H
 #define MATRICE_OPERATION_HEADER_H
 
+#include <stdint.h>
+
+#define SHUFFLE_BLOCKS 64 // blocks a parallel shuffle is cut into, must be a power of two
+#define PARALLEL_SHUFFLE_THRESHOLD (1 << 20) // arrays this large are shuffled on all cores
+
 void Clear_Array(int array[], int capacity); // clears an array
-void Sort_Array(int array[], int capacity); // sort array in ascending order
+void Sort_Array(int array[], int capacity); // sort used elements in ascending order into a dense prefix, unused elements trail
 void Shuffle_Array(int array[], int capacity); // Randomizes an array of integers, rearrange in random order 
+void Shuffle_Array_Seeded(int array[], int capacity, uint64_t seed); // Uniform shuffle that is reproducible for a given seed
 
 #endif 
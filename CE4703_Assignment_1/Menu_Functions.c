@@ -10,6 +10,9 @@
 #include "Simple_Operations_Header.h" // links to main header file
 #include "Maths_Operations_Header.h" // links to maths header file
 #include "Matrice_Operations_Header.h" // links to matrice header file
+#include "Stream_Operations_Header.h" // links to stream header file
+#include "Int_Array_Header.h" // links to the dense array handle
+#include "Pipeline_Header.h" // links to the pipelined stream reader
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -27,15 +30,18 @@
   * @param[in] capacity Capacity of the array (10 for this function)
   * @return int Always returns 0 indicating successful execution
   *
-  * @note Uses capacity of 10 as defined by capacity1 constant
-  * @see Array_Random(), Print_Used(), Print_All(), Clear_Array(), Sort_Array(), Find_Max(), Find_Min()
+  * @note Uses capacity of 10 as defined by capacity1 constant; any other
+  *       capacity fills the same share of the array (7/10, then 5/10)
+  * @note The second half runs on an IntArray handle, so the max and min
+  *       after the sort are read from the ends of the sorted data in O(1)
+  * @see Array_Random(), Print_Used(), Print_All(), Clear_Array(), Sort_Array_h(), Find_Max_h(), Find_Min_h()
   */
 int MF1(int array[], int capacity) {
     printf("\n\n----------------------------- Menu Function 1 ----------------------------- \n");
 
-    /** Fill array with 7 random numbers in range 10 to 20 using WF3 */
-    printf("WF3 Fill array with 7 random numbers in range 10 to 20 :");
-    Array_Random(array, 7, capacity, 10, 20);
+    /** Fill array with 7 random numbers (7/10 of capacity) in range 10 to 20 using WF3 */
+    printf("WF3 Fill array with %d random numbers in range 10 to 20 :", FILL_SHARE(capacity, 7, 10));
+    Array_Random(array, FILL_SHARE(capacity, 7, 10), capacity, 10, 20);
 
     /** Print used elements using WF7 */
     printf("\n\nWF7 Print used elements of the array :");
@@ -57,20 +63,24 @@ int MF1(int array[], int capacity) {
     printf("\n\nWF8 Print all elements in array after clearing :");
     Print_All(array, capacity);
 
-    /** Fill array with 5 random numbers in range 20 to 30 using WF3 */
-    printf("\n\nWF3 Fill array with 5 random numbers in range 20 to 30 :");
-    Array_Random(array, 5, capacity, 20, 30);
+    /** Track the array through a handle that remembers it has been sorted */
+    IntArray handle;
+    Int_Array_Wrap(&handle, array, capacity);
+
+    /** Fill array with 5 random numbers (5/10 of capacity) in range 20 to 30 using WF3 */
+    printf("\n\nWF3 Fill array with %d random numbers in range 20 to 30 :", FILL_SHARE(capacity, 5, 10));
+    Array_Random_h(&handle, FILL_SHARE(capacity, 5, 10), 20, 30);
 
     /** Sort array using WF5 */
     printf("\n\nWF5 to sort array :");
-    Sort_Array(array, capacity);
+    Sort_Array_h(&handle);
 
     /** Print all elements after sorting using WF8 */
     printf("\n\nWF8 Print all elements in array :");
-    Print_All(array, capacity);
+    Print_All_h(&handle);
 
-    /** Display maximum and minimum values in the array */
-    printf("\n\nThe max and min values in the array are [%d] and [%d]", Find_Max(array, capacity), Find_Min(array, capacity));
+    /** Display maximum and minimum values in the array, read from the sorted ends */
+    printf("\n\nThe max and min values in the array are [%d] and [%d]", Find_Max_h(&handle), Find_Min_h(&handle));
 
     return 0;
 }
@@ -88,15 +98,16 @@ int MF1(int array[], int capacity) {
  * @param[in] capacity Capacity of the array (20 for this function)
  * @return int Always returns 0 indicating successful execution
  *
- * @note Uses capacity of 20 as defined by capacity2 constant
+ * @note Uses capacity of 20 as defined by capacity2 constant; any other
+ *       capacity fills the same share of the array (15/20)
  * @see Array_Random(), Print_All(), Sort_Array(), Shuffle_Array()
  */
 int MF2(int array[], int capacity) {
     printf("\n\n----------------------------- Menu Function 2 ----------------------------- \n");
 
-    /** Fill array with 15 random numbers between 10 and 20 using WF3 */
-    printf("Wf3 to fill array with 15 random numbers between 10 and 20");
-    Array_Random(array, 15, capacity, 10, 20);
+    /** Fill array with 15 random numbers (15/20 of capacity) between 10 and 20 using WF3 */
+    printf("Wf3 to fill array with %d random numbers between 10 and 20", FILL_SHARE(capacity, 15, 20));
+    Array_Random(array, FILL_SHARE(capacity, 15, 20), capacity, 10, 20);
 
     /** Print all elements using WF8 */
     printf("\n\nWF8 Print all elements in array : ");
@@ -136,25 +147,61 @@ int MF2(int array[], int capacity) {
  * @return int Always returns 0 indicating successful execution
  *
  * @note Uses capacity of 100 as defined by capacity3 constant
- * @see Keyboard_Input(), Find_Max(), Find_Min(), Mean_Average(), Median_Average(),
- *      Variance(), Standard_Deviation(), Num_of_Used_Elements()
+ * @see Keyboard_Input_h(), Array_Stats_h(), Median_Average_h()
  */
 int MF3(int array[], int capacity) {
     printf("\n\n----------------------------- Menu Function 3 ----------------------------- \n");
 
-    /** Read up to 100 non-negative integers from keyboard input using WF2 */
-    printf("WF2 to read up to 100 non-negative integers from keyboard input : ");
-    Keyboard_Input(array, capacity);
+    /** Read up to capacity (100) non-negative integers from keyboard input using WF2 */
+    printf("WF2 to read up to %d non-negative integers from keyboard input : ", capacity);
+    IntArray handle;
+    Int_Array_Wrap(&handle, array, capacity);
+    Keyboard_Input_h(&handle);
+
+    /** Compute every summary statistic in a single pass over the used values; later queries hit the cache */
+    Array_Statistics stats;
+    Array_Stats_h(&handle, &stats);
 
     /** Display maximum and minimum values in the array */
-    printf("\n\nThe max and min values in the array are %d, %d ", Find_Max(array, capacity), Find_Min(array, capacity));
+    printf("\n\nThe max and min values in the array are %d, %d ", stats.max, stats.min);
 
     /** Display mean average and median values */
-    printf("\n\nArray has an average value of %.2f and a median value of %d", Mean_Average(array, capacity), Median_Average(array, capacity));
+    printf("\n\nArray has an average value of %.2f and a median value of %d", stats.mean, Median_Average_h(&handle));
 
     /** Display variance and standard deviation with used element count */
     printf("\n\nArray with %d used elements has a variance of %.2f and a standard deviation of %.2f",
-        Num_of_Used_Elements(array, capacity), Variance(array, capacity), Standard_Deviation(array, capacity));
+        stats.count, stats.variance, stats.standard_deviation);
+
+    return 0;
+}
+
+/**
+ * @brief Menu Function 4 - Streaming statistics over unbounded keyboard input
+ *
+ * Reads integers until a negative value or end of input and updates the
+ * statistics block by block, so there is no capacity limit and no array
+ * is needed. Parsing runs on its own thread while other threads compute
+ * the statistics, so long piped feeds are read at parsing speed.
+ *
+ * @return int Always returns 0 indicating successful execution
+ *
+ * @note Tail percentiles come from a fixed-size Quantile_Sketch, so they
+ *       are approximate but memory stays constant
+ * @see Pipeline_Input(), Stream_Stats_Report(), Stream_Stats_Attach()
+ */
+int MF4(void) {
+    printf("\n\n----------------------------- Menu Function 4 ----------------------------- \n");
+
+    /** Read any number of non-negative integers, parsing and updating the statistics on separate threads */
+    printf("Enter non-negative integers (negative value or end of input to stop) : ");
+    static Quantile_Sketch sketch; /**< Fixed-size percentile sketch, too large for the stack frame of a menu */
+    Stream_Statistics stats;
+    Stream_Stats_Init(&stats);
+    Stream_Stats_Attach(&stats, &sketch);
+    Pipeline_Input(Parser_Stdin(), &stats, 1);
+
+    /** Display the final report of the stream */
+    Stream_Stats_Report(&stats);
 
     return 0;
 }
\ No newline at end of file
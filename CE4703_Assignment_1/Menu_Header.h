@@ -4,10 +4,12 @@
 #define capacity1 10
 #define capacity2 20
 #define capacity3 100
+#define FILL_SHARE(capacity, numerator, denominator) ((int)((long long)(capacity) * (numerator) / (denominator))) // share of capacity, e.g. 7/10 of 10 = 7
 
 
 int MF1(int array[], int capacity); // menu function 1 capacity = 10
 int MF2(int array[], int capacity); // menu function 2 capacity = 20
 int MF3(int array[], int capacity); // menu function 3 capacity = 100
+int MF4(void); // menu function 4 streaming statistics, no capacity limit
 
 #endif // menu_header_h
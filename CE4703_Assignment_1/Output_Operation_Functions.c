@@ -0,0 +1,230 @@
+/**
+ * @file Output_Operation_Functions.c
+ * @brief Buffered array output with a hand-written integer formatter
+ *
+ * Values are formatted into a large reusable buffer, two digits at a time
+ * from a lookup table, and the buffer is passed to write() once it is
+ * full. Printing an array therefore costs one system call per buffer
+ * instead of one printf() format parse and stream lock per element.
+ */
+
+#include "Output_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include <stdio.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <io.h>
+#define write(fd, buffer, size) _write((fd), (buffer), (unsigned int)(size))
+#else
+#include <unistd.h>
+#endif
+
+#define OUTPUT_INT_CHARS 12 // longest decimal int: sign plus ten digits, rounded up
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"; /**< Two decimal digits for every value 0..99 */
+
+static char stdout_buffer[OUTPUT_BUFFER_SIZE]; /**< Buffer of the shared stdout writer */
+static Output_Writer stdout_writer = { 1, stdout_buffer, OUTPUT_BUFFER_SIZE, 0, 0 };
+static int print_layout = OUTPUT_LAYOUT_TEXT; /**< Layout used by Print_Used() and Print_All() */
+
+ /**
+  * @brief Formats a value into the end of a small scratch area
+  *
+  * @param[in] value Value to format
+  * @param[out] end One past the last byte of the scratch area
+  * @return char* First byte of the formatted text
+  */
+static char* Format_Int(int value, char* end) {
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+    char* cursor = end;
+
+    while (magnitude >= 100) {
+        unsigned int pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        cursor -= 2;
+        cursor[0] = digit_pairs[pair];
+        cursor[1] = digit_pairs[pair + 1];
+    }
+    if (magnitude >= 10) {
+        cursor -= 2;
+        cursor[0] = digit_pairs[magnitude * 2];
+        cursor[1] = digit_pairs[magnitude * 2 + 1];
+    }
+    else {
+        *--cursor = (char)('0' + magnitude);
+    }
+    if (value < 0) {
+        *--cursor = '-';
+    }
+    return cursor;
+}
+
+/**
+ * @brief Attaches a writer to a file descriptor
+ *
+ * The writer does not own either the descriptor or the buffer.
+ *
+ * @param[out] writer Writer to initialise
+ * @param[in] fd Open, writable file descriptor
+ * @param[in] buffer Output buffer, at least size bytes
+ * @param[in] size Size of buffer in bytes
+ *
+ * @return void
+ */
+void Output_Init(Output_Writer* writer, int fd, char* buffer, int size) {
+    writer->fd = fd;
+    writer->buffer = buffer;
+    writer->size = size;
+    writer->length = 0;
+    writer->failed = 0;
+}
+
+/**
+ * @brief Returns the shared writer over standard output
+ *
+ * @return Output_Writer* Writer on descriptor 1
+ */
+Output_Writer* Output_Stdout(void) {
+    return &stdout_writer;
+}
+
+/**
+ * @brief Appends raw bytes to the writer
+ *
+ * @param[in,out] writer Writer to append to
+ * @param[in] bytes Bytes to append
+ * @param[in] count Number of bytes
+ *
+ * @return void
+ */
+void Output_Bytes(Output_Writer* writer, const char* bytes, int count) {
+    while (count > 0) {
+        int room = writer->size - writer->length;
+        if (room == 0) {
+            Output_Flush(writer);
+            room = writer->size;
+        }
+        int chunk = (count < room) ? count : room;
+        memcpy(writer->buffer + writer->length, bytes, (size_t)chunk);
+        writer->length += chunk;
+        bytes += chunk;
+        count -= chunk;
+    }
+}
+
+/**
+ * @brief Appends a value in decimal
+ *
+ * @param[in,out] writer Writer to append to
+ * @param[in] value Value to append
+ *
+ * @return void
+ */
+void Output_Int(Output_Writer* writer, int value) {
+    char scratch[OUTPUT_INT_CHARS];
+    char* end = scratch + OUTPUT_INT_CHARS;
+    char* text = Format_Int(value, end);
+
+    Output_Bytes(writer, text, (int)(end - text));
+}
+
+/**
+ * @brief Writes out everything buffered
+ *
+ * Anything still held by printf() is flushed first so output from both
+ * paths appears in program order.
+ *
+ * @param[in,out] writer Writer to flush
+ * @return int 0 on success, -1 if write() failed
+ */
+int Output_Flush(Output_Writer* writer) {
+    int offset = 0;
+
+    if (writer->fd == 1) {
+        fflush(stdout);
+    }
+    while (offset < writer->length) {
+        int written = (int)write(writer->fd, writer->buffer + offset, writer->length - offset);
+        if (written <= 0) {
+            writer->failed = 1;
+            break;
+        }
+        offset += written;
+    }
+    writer->length = 0;
+    return writer->failed ? -1 : 0;
+}
+
+/**
+ * @brief Appends an array in the given layout
+ *
+ * OUTPUT_LAYOUT_TEXT reproduces the "\nArray[i] | value" lines of
+ * Print_All(). OUTPUT_LAYOUT_CSV writes the values separated by commas
+ * and OUTPUT_LAYOUT_LINES writes one value per line; both end with a
+ * newline and leave out the indices.
+ *
+ * @param[in,out] writer Writer to append to
+ * @param[in] array Array to write
+ * @param[in] capacity Total number of elements in array
+ * @param[in] layout One of the OUTPUT_LAYOUT_ values
+ * @param[in] used_only Non-zero to skip unused elements
+ *
+ * @return void
+ */
+void Output_Array(Output_Writer* writer, const int array[], int capacity, int layout, int used_only) {
+    static const char prefix[] = "\nArray[";
+    static const char separator[] = "] | ";
+    int first = 1;
+
+    for (int i = 0; i < capacity; i++) {
+        if (used_only && !IS_USED(array[i])) {
+            continue;
+        }
+        if (layout == OUTPUT_LAYOUT_TEXT) {
+            Output_Bytes(writer, prefix, (int)sizeof(prefix) - 1);
+            Output_Int(writer, i);
+            Output_Bytes(writer, separator, (int)sizeof(separator) - 1);
+            Output_Int(writer, array[i]);
+        }
+        else {
+            if (!first) {
+                Output_Bytes(writer, (layout == OUTPUT_LAYOUT_CSV) ? "," : "\n", 1);
+            }
+            Output_Int(writer, array[i]);
+        }
+        first = 0;
+    }
+    if (layout != OUTPUT_LAYOUT_TEXT) {
+        Output_Bytes(writer, "\n", 1);
+    }
+}
+
+/**
+ * @brief Selects the layout used by Print_Used() and Print_All()
+ *
+ * @param[in] layout One of the OUTPUT_LAYOUT_ values
+ *
+ * @return void
+ */
+void Output_Set_Layout(int layout) {
+    print_layout = layout;
+}
+
+/**
+ * @brief Returns the layout used by Print_Used() and Print_All()
+ *
+ * @return int One of the OUTPUT_LAYOUT_ values
+ */
+int Output_Layout(void) {
+    return print_layout;
+}
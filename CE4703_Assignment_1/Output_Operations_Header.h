@@ -0,0 +1,32 @@
+#ifndef OUTPUT_OPERATIONS_HEADER_H
+#define OUTPUT_OPERATIONS_HEADER_H // include guard
+
+#define OUTPUT_BUFFER_SIZE (1 << 16) // bytes formatted before each write()
+#define OUTPUT_LAYOUT_TEXT 0 // "\nArray[i] | value" per element, the original layout
+#define OUTPUT_LAYOUT_CSV 1 // values separated by commas, one line
+#define OUTPUT_LAYOUT_LINES 2 // one value per line
+
+/**
+ * @brief Buffered writer over a file descriptor
+ *
+ * Text is formatted straight into the buffer and handed to write() one
+ * full buffer at a time.
+ */
+typedef struct Output_Writer {
+    int fd; // descriptor being written
+    char* buffer; // caller supplied buffer
+    int size; // size of buffer in bytes
+    int length; // bytes waiting to be written
+    int failed; // set if write() returned an error
+} Output_Writer;
+
+void Output_Init(Output_Writer* writer, int fd, char* buffer, int size); // attaches a writer to fd using the given buffer
+Output_Writer* Output_Stdout(void); // shared writer over standard output
+void Output_Bytes(Output_Writer* writer, const char* bytes, int count); // appends raw bytes
+void Output_Int(Output_Writer* writer, int value); // appends a value in decimal
+int Output_Flush(Output_Writer* writer); // writes out everything buffered, returns 0 or -1 on error
+void Output_Array(Output_Writer* writer, const int array[], int capacity, int layout, int used_only); // appends an array in the given layout
+void Output_Set_Layout(int layout); // layout used by Print_Used() and Print_All()
+int Output_Layout(void); // current layout of Print_Used() and Print_All()
+
+#endif // OUTPUT_OPERATIONS_HEADER_H
@@ -0,0 +1,248 @@
+/**
+ * @file Parallel_Functions.c
+ * @brief Persistent worker pool for running tasks on several threads
+ *
+ * Parallel_Run() spreads a numbered set of tasks over a pool of worker
+ * threads and returns once every task has finished. The pool is started
+ * on first use and reused by every later call. Threads are created with
+ * the Win32 API on Windows and with pthreads elsewhere.
+ */
+
+#include "Parallel_Header.h" // linking the header definitions
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief State of the persistent worker pool
+ *
+ * Workers sleep on work_ready until the generation number changes, then
+ * claim task indices one at a time under the lock until none are left.
+ * The last task to finish signals work_done.
+ */
+typedef struct Parallel_Pool {
+#if defined(_WIN32)
+    SRWLOCK lock;
+    CONDITION_VARIABLE work_ready;
+    CONDITION_VARIABLE work_done;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+#endif
+    int workers; // worker threads started so far (the caller is not counted)
+    int active_workers; // workers allowed to take tasks from the current job
+    unsigned int generation; // incremented for every job
+    int busy; // set while a job is running, nested calls run inline
+    Parallel_Task task; // current job
+    void* context;
+    int task_count;
+    int next_task; // next unclaimed task index
+    int finished_tasks; // tasks completed so far
+} Parallel_Pool;
+
+#if defined(_WIN32)
+static Parallel_Pool pool = { SRWLOCK_INIT, CONDITION_VARIABLE_INIT, CONDITION_VARIABLE_INIT, 0, 0, 0, 0, NULL, NULL, 0, 0, 0 };
+#define POOL_LOCK() AcquireSRWLockExclusive(&pool.lock)
+#define POOL_UNLOCK() ReleaseSRWLockExclusive(&pool.lock)
+#define POOL_WAIT(condition) SleepConditionVariableSRW(&(condition), &pool.lock, INFINITE, 0)
+#define POOL_BROADCAST(condition) WakeAllConditionVariable(&(condition))
+#else
+static Parallel_Pool pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, 0, NULL, NULL, 0, 0, 0 };
+#define POOL_LOCK() pthread_mutex_lock(&pool.lock)
+#define POOL_UNLOCK() pthread_mutex_unlock(&pool.lock)
+#define POOL_WAIT(condition) pthread_cond_wait(&(condition), &pool.lock)
+#define POOL_BROADCAST(condition) pthread_cond_broadcast(&(condition))
+#endif
+
+static int requested_threads = 0; /**< Thread count set by Parallel_Set_Threads(), 0 = default */
+static int online_cpus = 0; /**< Number of online CPUs, 0 until first detected */
+static unsigned int start_generation[PARALLEL_MAX_THREADS]; /**< Generation before the job each worker was started for */
+
+ /**
+  * @brief Claims and runs tasks of the current job until none are left
+  *
+  * Must be called with the pool lock held; the lock is released while
+  * each task runs and held again on return.
+  */
+static void Run_Tasks(void) {
+    Parallel_Task task = pool.task;
+    void* context = pool.context;
+
+    while (pool.next_task < pool.task_count) {
+        int index = pool.next_task++;
+        POOL_UNLOCK();
+        task(context, index);
+        POOL_LOCK();
+        if (++pool.finished_tasks == pool.task_count) {
+            POOL_BROADCAST(pool.work_done);
+        }
+    }
+}
+
+/**
+ * @brief Main loop of a pool worker
+ *
+ * Starts from the generation recorded when the thread was created rather
+ * than the current one, so a worker started for a job still sees that
+ * job even though the generation was bumped before the thread ran.
+ *
+ * @param[in] worker_index Zero-based worker number
+ */
+static void Worker_Loop(int worker_index) {
+    unsigned int seen_generation;
+
+    POOL_LOCK();
+    seen_generation = start_generation[worker_index];
+    for (;;) {
+        while (pool.generation == seen_generation) {
+            POOL_WAIT(pool.work_ready);
+        }
+        seen_generation = pool.generation;
+        if (worker_index < pool.active_workers) {
+            Run_Tasks();
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_Entry(LPVOID argument) {
+    Worker_Loop((int)(INT_PTR)argument);
+    return 0;
+}
+#else
+static void* Thread_Entry(void* argument) {
+    Worker_Loop((int)(intptr_t)argument);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Starts workers until the pool has the requested number
+ *
+ * Must be called with the pool lock held and before the generation of
+ * the next job is bumped. Stops early if a thread cannot be created; the
+ * jobs then simply run on fewer threads.
+ *
+ * @param[in] wanted Number of worker threads wanted
+ */
+static void Grow_Pool(int wanted) {
+    while (pool.workers < wanted) {
+        start_generation[pool.workers] = pool.generation; /**< Read by the new worker under the lock */
+#if defined(_WIN32)
+        HANDLE handle = CreateThread(NULL, 0, Thread_Entry, (LPVOID)(INT_PTR)pool.workers, 0, NULL);
+        if (handle == NULL) {
+            return;
+        }
+        CloseHandle(handle); /**< Workers live for the whole run */
+#else
+        pthread_t handle;
+        if (pthread_create(&handle, NULL, Thread_Entry, (void*)(intptr_t)pool.workers) != 0) {
+            return;
+        }
+        pthread_detach(handle); /**< Workers live for the whole run */
+#endif
+        pool.workers++;
+    }
+}
+
+/**
+ * @brief Returns the number of threads used by Parallel_Run()
+ *
+ * The CPU count is detected on the first call and cached, since the query
+ * reads a system file on Linux and this runs for every statistic and sort.
+ * The first call is made before any job starts, so workers only read it.
+ *
+ * @return int Value set by Parallel_Set_Threads(), or the number of online CPUs
+ */
+int Parallel_Thread_Count(void) {
+    int threads = requested_threads;
+
+    if (threads <= 0) {
+        if (online_cpus == 0) {
+#if defined(_WIN32)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            online_cpus = (int)info.dwNumberOfProcessors;
+#else
+            online_cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        }
+        threads = online_cpus;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    if (threads > PARALLEL_MAX_THREADS) {
+        threads = PARALLEL_MAX_THREADS;
+    }
+    return threads;
+}
+
+/**
+ * @brief Overrides the number of threads used by Parallel_Run()
+ *
+ * @param[in] threads Thread count, or 0 to use the number of CPUs
+ *
+ * @return void
+ */
+void Parallel_Set_Threads(int threads) {
+    requested_threads = (threads > 0) ? threads : 0;
+}
+
+/**
+ * @brief Runs task(context, i) for every i in [0, task_count) across threads
+ *
+ * Work is handed to a pool of worker threads that is created on first use
+ * and kept for later calls, so small jobs do not pay for thread creation.
+ * The calling thread takes part in the work. Tasks are claimed one at a
+ * time, so uneven tasks balance themselves.
+ *
+ * @param[in] task_count Number of tasks
+ * @param[in] task Function to call for each task index
+ * @param[in] context Caller data passed to every call
+ *
+ * @return void
+ *
+ * @note Tasks must not depend on the order in which they run. A call made
+ *       from inside a task runs its tasks on the calling thread.
+ */
+void Parallel_Run(int task_count, Parallel_Task task, void* context) {
+    int threads = Parallel_Thread_Count(); /**< Threads including the caller */
+
+    if (threads > task_count) {
+        threads = task_count;
+    }
+
+    POOL_LOCK();
+    if (threads <= 1 || pool.busy) {
+        POOL_UNLOCK();
+        for (int i = 0; i < task_count; i++) {
+            task(context, i);
+        }
+        return;
+    }
+
+    pool.busy = 1;
+    Grow_Pool(threads - 1);
+    pool.active_workers = threads - 1;
+    pool.task = task;
+    pool.context = context;
+    pool.task_count = task_count;
+    pool.next_task = 0;
+    pool.finished_tasks = 0;
+    pool.generation++;
+    POOL_BROADCAST(pool.work_ready);
+
+    Run_Tasks();
+    while (pool.finished_tasks < pool.task_count) {
+        POOL_WAIT(pool.work_done);
+    }
+    pool.busy = 0;
+    POOL_UNLOCK();
+}
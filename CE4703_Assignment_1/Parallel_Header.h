@@ -0,0 +1,12 @@
+#ifndef PARALLEL_HEADER_H
+#define PARALLEL_HEADER_H // include guard
+
+#define PARALLEL_MAX_THREADS 256 // upper bound on worker threads
+
+typedef void (*Parallel_Task)(void* context, int task_index); // one unit of work, called once per task index
+
+int Parallel_Thread_Count(void); // number of threads Parallel_Run() uses, caller included (defaults to the number of CPUs)
+void Parallel_Set_Threads(int threads); // overrides the thread count, 0 restores the default
+void Parallel_Run(int task_count, Parallel_Task task, void* context); // runs task(context, i) for every i in [0, task_count) and waits for all
+
+#endif // PARALLEL_HEADER_H
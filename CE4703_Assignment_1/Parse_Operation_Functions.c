@@ -0,0 +1,197 @@
+/**
+ * @file Parse_Operation_Functions.c
+ * @brief Bulk integer parser for keyboard, pipe and file input
+ *
+ * Input is pulled from a file descriptor in large blocks with read() and
+ * integers are parsed by hand directly from the block. This replaces one
+ * scanf_s() call per value, which parses a format string and locks the
+ * stream every time.
+ */
+
+#include "Parse_Operations_Header.h" // linking the header definitions
+#include <limits.h>
+#include <stdio.h>
+#if defined(_WIN32)
+#include <io.h>
+#define read(fd, buffer, size) _read((fd), (buffer), (unsigned int)(size))
+#else
+#include <unistd.h>
+#endif
+
+#define PARSE_MAX_DIGITS 10 // digits in INT_MAX, longer tokens always overflow
+#define IS_SPACE(c) ((c) == ' ' || (c) == '\n' || (c) == '\t' || (c) == '\r' || (c) == '\v' || (c) == '\f')
+#define IS_DIGIT(c) ((unsigned int)((c) - '0') <= 9u)
+
+static char stdin_buffer[PARSE_BUFFER_SIZE]; /**< Block buffer of the shared stdin parser */
+static Int_Parser stdin_parser = { 0, stdin_buffer, PARSE_BUFFER_SIZE, 0, 0, 0, -1, 0, 0 };
+
+ /**
+  * @brief Reads the next block from the descriptor
+  *
+  * @param[in,out] parser Parser to refill
+  * @return int Non-zero if new bytes are available, 0 at end of input
+  */
+static int Refill(Int_Parser* parser) {
+    int got;
+
+    if (parser->at_end) {
+        return 0;
+    }
+    parser->offset += parser->length;
+    parser->position = 0;
+    parser->length = 0;
+    if (parser->fd == 0) {
+        fflush(stdout); /**< Make any prompt visible before blocking on the keyboard */
+    }
+    got = (int)read(parser->fd, parser->buffer, parser->size);
+    if (got <= 0) {
+        parser->at_end = 1;
+        parser->failed = (got < 0);
+        return 0;
+    }
+    parser->length = got;
+    return 1;
+}
+
+/**
+ * @brief Attaches a parser to a file descriptor
+ *
+ * The parser does not own either the descriptor or the buffer.
+ *
+ * @param[out] parser Parser to initialise
+ * @param[in] fd Open, readable file descriptor
+ * @param[in] buffer Block buffer, at least size bytes
+ * @param[in] size Size of buffer in bytes
+ *
+ * @return void
+ */
+void Parser_Init(Int_Parser* parser, int fd, char* buffer, int size) {
+    parser->fd = fd;
+    parser->buffer = buffer;
+    parser->size = size;
+    parser->position = 0;
+    parser->length = 0;
+    parser->offset = 0;
+    parser->error_offset = -1;
+    parser->at_end = 0;
+    parser->failed = 0;
+}
+
+/**
+ * @brief Returns the shared parser over standard input
+ *
+ * Every keyboard read in the program goes through this one parser, so
+ * bytes it has already buffered are never lost to another reader.
+ *
+ * @return Int_Parser* Parser reading descriptor 0
+ */
+Int_Parser* Parser_Stdin(void) {
+    return &stdin_parser;
+}
+
+/**
+ * @brief Parses the next whitespace separated integer
+ *
+ * Leading whitespace (spaces, tabs and newlines) is skipped and an
+ * optional sign is accepted. A token that holds anything other than
+ * digits, or that does not fit in an int, is skipped as a whole and
+ * reported as malformed; its stream offset is stored in error_offset so
+ * the caller can point at it.
+ *
+ * @param[in,out] parser Parser to read from
+ * @param[out] value Receives the parsed value when PARSE_VALUE is returned
+ * @return int PARSE_VALUE, PARSE_END or PARSE_MALFORMED
+ *
+ * @code
+ * // input "12 -4 x7 9"
+ * Parser_Next(parser, &v); // PARSE_VALUE, v = 12
+ * Parser_Next(parser, &v); // PARSE_VALUE, v = -4
+ * Parser_Next(parser, &v); // PARSE_MALFORMED, error_offset = 6
+ * Parser_Next(parser, &v); // PARSE_VALUE, v = 9
+ * @endcode
+ */
+int Parser_Next(Int_Parser* parser, int* value) {
+    unsigned long long magnitude = 0; /**< Digits seen so far, only meaningful up to PARSE_MAX_DIGITS */
+    long long start;
+    int digits = 0;
+    int negative = 0;
+    int malformed = 0;
+    int c;
+
+    /** Skip separators, refilling as needed */
+    for (;;) {
+        while (parser->position < parser->length && IS_SPACE(parser->buffer[parser->position])) {
+            parser->position++;
+        }
+        if (parser->position < parser->length) {
+            break;
+        }
+        if (!Refill(parser)) {
+            return PARSE_END;
+        }
+    }
+
+    start = parser->offset + parser->position;
+    c = parser->buffer[parser->position];
+    if (c == '-' || c == '+') {
+        negative = (c == '-');
+        parser->position++;
+    }
+
+    /** Accumulate digits; a token may continue across a block boundary */
+    for (;;) {
+        const char* cursor = parser->buffer + parser->position;
+        const char* end = parser->buffer + parser->length;
+
+        while (cursor < end && IS_DIGIT(*cursor)) {
+            magnitude = magnitude * 10 + (unsigned long long)(*cursor - '0');
+            digits++;
+            cursor++;
+        }
+        while (cursor < end && !IS_SPACE(*cursor)) {
+            malformed = 1; /**< Anything else up to the next separator belongs to a bad token */
+            cursor++;
+        }
+        parser->position = (int)(cursor - parser->buffer);
+        if (cursor < end || !Refill(parser)) {
+            break;
+        }
+    }
+
+    if (malformed || digits == 0 || digits > PARSE_MAX_DIGITS
+        || magnitude > (unsigned long long)INT_MAX + (unsigned long long)negative) {
+        parser->error_offset = start;
+        return PARSE_MALFORMED;
+    }
+    *value = (int)(negative ? -(long long)magnitude : (long long)magnitude);
+    return PARSE_VALUE;
+}
+
+/**
+ * @brief Discards input up to and including the next newline
+ *
+ * @param[in,out] parser Parser to read from
+ * @return int Non-zero if a newline was found, 0 if input ended first
+ */
+int Parser_Skip_Line(Int_Parser* parser) {
+    for (;;) {
+        while (parser->position < parser->length) {
+            if (parser->buffer[parser->position++] == '\n') {
+                return 1;
+            }
+        }
+        if (!Refill(parser)) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Returns the stream offset of the next unparsed byte
+ *
+ * @param[in] parser Parser to query
+ * @return long long Bytes consumed from the descriptor so far
+ */
+long long Parser_Offset(const Int_Parser* parser) {
+    return parser->offset + parser->position;
+}
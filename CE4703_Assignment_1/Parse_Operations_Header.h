@@ -0,0 +1,34 @@
+#ifndef PARSE_OPERATIONS_HEADER_H
+#define PARSE_OPERATIONS_HEADER_H // include guard
+
+#define PARSE_BUFFER_SIZE (1 << 16) // bytes pulled from the descriptor per read
+#define PARSE_VALUE 1 // Parser_Next() stored a value
+#define PARSE_END 0 // Parser_Next() reached the end of input
+#define PARSE_MALFORMED -1 // Parser_Next() skipped a token that is not an int
+
+/**
+ * @brief Buffered integer reader over a file descriptor
+ *
+ * Pulls large blocks with read() and parses whitespace separated integers
+ * straight out of the block, so there is no format string and no stream
+ * lock per value.
+ */
+typedef struct Int_Parser {
+    int fd; // descriptor being read
+    char* buffer; // caller supplied block buffer
+    int size; // size of buffer in bytes
+    int position; // next unparsed byte in buffer
+    int length; // bytes currently held in buffer
+    long long offset; // stream offset of buffer[0]
+    long long error_offset; // stream offset of the last malformed token, -1 if none
+    int at_end; // set once read() has returned end of input or an error
+    int failed; // set if read() returned an error
+} Int_Parser;
+
+void Parser_Init(Int_Parser* parser, int fd, char* buffer, int size); // attaches a parser to fd using the given buffer
+Int_Parser* Parser_Stdin(void); // shared parser over standard input, used by every keyboard read
+int Parser_Next(Int_Parser* parser, int* value); // parses the next integer, returns PARSE_VALUE, PARSE_END or PARSE_MALFORMED
+int Parser_Skip_Line(Int_Parser* parser); // discards input up to and including the next newline, returns 0 at end of input
+long long Parser_Offset(const Int_Parser* parser); // stream offset of the next unparsed byte
+
+#endif // PARSE_OPERATIONS_HEADER_H
@@ -0,0 +1,342 @@
+/**
+ * @file Pipeline_Functions.c
+ * @brief Parsing and statistics overlapped on separate threads
+ *
+ * Stream_Input_Parsed() reads, parses and updates the statistics one
+ * value at a time on one thread, so its throughput is bounded by the sum
+ * of the three. Pipeline_Input() runs the parser on one thread, packing
+ * values into fixed-size blocks, while worker threads take the blocks and
+ * fold them into their own partial Stream_Statistics. The partials are
+ * merged when input ends, so ingestion runs at the speed of the slowest
+ * stage instead.
+ *
+ * Blocks travel through a bounded lock-free ring (Vyukov's sequence
+ * numbered queue): each slot carries a sequence number that says whether
+ * it is free for the parser or holds a block for a worker, so the parser
+ * and any number of workers hand off blocks with one atomic compare and
+ * swap and no lock. When every slot is full the parser does not block; it
+ * takes a block and processes it itself, which throttles it to the
+ * workers' pace and can never deadlock, even if the pool runs the tasks
+ * one after another.
+ */
+
+#define _POSIX_C_SOURCE 199309L // nanosleep() under -std=c11
+
+#include "Pipeline_Header.h" // linking the header definitions
+#include "Parallel_Header.h" // linking the worker pool
+#include "Arena_Header.h" // linking the scratch arena
+#include <stdio.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef volatile LONG Ring_Counter;
+#define RING_LOAD(counter) ReadAcquire(counter)
+#define RING_STORE(counter, value) WriteRelease((counter), (value))
+#define RING_COMPARE_EXCHANGE(counter, expected, desired) (InterlockedCompareExchange((counter), (desired), (expected)) == (expected))
+#else
+#include <sched.h>
+#include <time.h>
+typedef volatile long Ring_Counter;
+#define RING_LOAD(counter) __atomic_load_n((counter), __ATOMIC_ACQUIRE)
+#define RING_STORE(counter, value) __atomic_store_n((counter), (value), __ATOMIC_RELEASE)
+#define RING_COMPARE_EXCHANGE(counter, expected, desired) Compare_Exchange((counter), (expected), (desired))
+
+static int Compare_Exchange(Ring_Counter* counter, long expected, long desired) {
+    return __atomic_compare_exchange_n(counter, &expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#endif
+
+#define RING_CACHE_LINE 64 // padding that keeps the parser's and the workers' counters apart
+
+/**
+ * @brief One slot of the block ring
+ *
+ * sequence equals the slot's next fill position while the slot is free
+ * and that position + 1 once a block has been published in it.
+ */
+typedef struct Ring_Slot {
+    Ring_Counter sequence; // hand-off state, see above
+    int count; // values in the block
+    int* values; // PIPELINE_BLOCK_VALUES ints
+} Ring_Slot;
+
+/**
+ * @brief Bounded ring of blocks from the parser to the workers
+ */
+typedef struct Block_Ring {
+    Ring_Slot* slots; // PIPELINE_SLOTS slots
+    long head; // next position the parser fills, touched only by the parser
+    char pad_head[RING_CACHE_LINE];
+    Ring_Counter tail; // next position a worker takes
+    char pad_tail[RING_CACHE_LINE];
+    Ring_Counter finished; // set once the parser has published its last block
+} Block_Ring;
+
+/**
+ * @brief Shared state of one Pipeline_Input() call
+ */
+typedef struct Pipeline_Job {
+    Block_Ring ring; // blocks in flight
+    Int_Parser* parser; // input, read by task 0 only
+    int stop_at_negative; // non-zero to end input at a negative value
+    Stream_Statistics* partials; // one per task
+    long long added; // values parsed, written by task 0
+} Pipeline_Job;
+
+/**
+ * @brief Waits a little before an idle thread polls the ring again
+ *
+ * Yields for the first PIPELINE_SPINS calls, then sleeps a millisecond
+ * per call so workers waiting on slow (e.g. keyboard) input stay idle.
+ *
+ * @param[in,out] idle Consecutive idle polls, reset by the caller on progress
+ */
+static void Pipeline_Pause(int* idle) {
+    if ((*idle)++ < PIPELINE_SPINS) {
+#if defined(_WIN32)
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+        return;
+    }
+#if defined(_WIN32)
+    Sleep(1);
+#else
+    struct timespec pause = { 0, 1000000 };
+    nanosleep(&pause, NULL);
+#endif
+}
+
+/**
+ * @brief Returns the slot at the parser's position if it is free
+ *
+ * @param[in] ring Block ring
+ * @return Ring_Slot* Slot to fill, NULL while every slot holds a block
+ */
+static Ring_Slot* Ring_Claim(Block_Ring* ring) {
+    Ring_Slot* slot = &ring->slots[ring->head & (PIPELINE_SLOTS - 1)];
+
+    return (RING_LOAD(&slot->sequence) == ring->head) ? slot : NULL;
+}
+
+/**
+ * @brief Hands a filled slot to the workers
+ *
+ * @param[in,out] ring Block ring
+ * @param[in,out] slot Slot returned by Ring_Claim(), with count and values set
+ */
+static void Ring_Publish(Block_Ring* ring, Ring_Slot* slot) {
+    RING_STORE(&slot->sequence, ring->head + 1);
+    ring->head++;
+}
+
+/**
+ * @brief Takes the oldest published block, if any
+ *
+ * Safe to call from any number of threads at once.
+ *
+ * @param[in,out] ring Block ring
+ * @param[out] position Position of the block, to pass to Ring_Release()
+ * @return Ring_Slot* Slot holding the block, NULL if no block is waiting
+ */
+static Ring_Slot* Ring_Take(Block_Ring* ring, long* position) {
+    long tail = RING_LOAD(&ring->tail);
+
+    for (;;) {
+        Ring_Slot* slot = &ring->slots[tail & (PIPELINE_SLOTS - 1)];
+        long ready = (long)((unsigned long)RING_LOAD(&slot->sequence) - (unsigned long)(tail + 1)); /**< 0 when published for this position */
+
+        if (ready == 0) {
+            if (RING_COMPARE_EXCHANGE(&ring->tail, tail, tail + 1)) {
+                *position = tail;
+                return slot;
+            }
+        }
+        else if (ready < 0) {
+            return NULL; /**< Not yet published: the ring is empty */
+        }
+        tail = RING_LOAD(&ring->tail); /**< Another thread took it, try the next position */
+    }
+}
+
+/**
+ * @brief Returns a processed slot to the parser
+ *
+ * @param[in,out] slot Slot returned by Ring_Take()
+ * @param[in] position Position returned by Ring_Take()
+ */
+static void Ring_Release(Ring_Slot* slot, long position) {
+    RING_STORE(&slot->sequence, position + PIPELINE_SLOTS);
+}
+
+/**
+ * @brief Takes one block, folds it into a partial and frees the slot
+ *
+ * @param[in,out] job Pipeline state
+ * @param[in,out] partial Statistics of the calling task
+ * @return int 1 if a block was processed, 0 if the ring was empty
+ */
+static int Process_Block(Pipeline_Job* job, Stream_Statistics* partial) {
+    long position;
+    Ring_Slot* slot = Ring_Take(&job->ring, &position);
+
+    if (slot == NULL) {
+        return 0;
+    }
+    Stream_Stats_Add_Block(partial, slot->values, slot->count);
+    Ring_Release(slot, position);
+    return 1;
+}
+
+/**
+ * @brief Parses values into a block until it is full or input ends
+ *
+ * @param[in,out] job Pipeline state
+ * @param[out] values Block to fill
+ * @param[out] count Values stored
+ * @return int 1 if input continues after the block, 0 if it ended
+ */
+static int Fill_Block(Pipeline_Job* job, int values[], int* count) {
+    int value;
+    int status;
+    int stored = 0;
+
+    while (stored < PIPELINE_BLOCK_VALUES) {
+        status = Parser_Next(job->parser, &value);
+        if (status == PARSE_END) {
+            break;
+        }
+        if (status == PARSE_MALFORMED) {
+            fprintf(stderr, "Skipping malformed input at byte %lld\n", job->parser->error_offset);
+            continue;
+        }
+        if (job->stop_at_negative && value < 0) {
+            break;
+        }
+        values[stored++] = value;
+    }
+    *count = stored;
+    return stored == PIPELINE_BLOCK_VALUES;
+}
+
+/**
+ * @brief Parallel task: task 0 parses, every other task processes blocks
+ */
+static void Pipeline_Task(void* context, int task) {
+    Pipeline_Job* job = context;
+    Stream_Statistics* partial = &job->partials[task];
+    int idle = 0;
+
+    if (task == 0) {
+        int more = 1;
+        while (more) {
+            Ring_Slot* slot = Ring_Claim(&job->ring);
+            if (slot == NULL) {
+                /* Ring full: help the workers instead of blocking */
+                if (Process_Block(job, partial)) {
+                    idle = 0;
+                }
+                else {
+                    Pipeline_Pause(&idle);
+                }
+                continue;
+            }
+            more = Fill_Block(job, slot->values, &slot->count);
+            job->added += slot->count;
+            Ring_Publish(&job->ring, slot);
+            idle = 0;
+        }
+        RING_STORE(&job->ring.finished, 1);
+        return;
+    }
+
+    for (;;) {
+        if (Process_Block(job, partial)) {
+            idle = 0;
+            continue;
+        }
+        if (RING_LOAD(&job->ring.finished)) {
+            /* Every block is published; drain what is left and stop */
+            while (Process_Block(job, partial)) {
+            }
+            return;
+        }
+        Pipeline_Pause(&idle);
+    }
+}
+
+/**
+ * @brief Reads integers through a bulk parser with parsing and statistics overlapped
+ *
+ * Gives the same statistics as Stream_Input_Parsed() (up to rounding of
+ * the mean and variance), but task 0 of the worker pool only parses
+ * while up to PIPELINE_MAX_WORKERS other tasks update partial statistics
+ * from the blocks it hands over. At most PIPELINE_SLOTS blocks are in
+ * flight, so memory stays bounded however fast the parser is. An attached
+ * sketch receives every value through per-task sketches merged at the end.
+ *
+ * @param[in,out] parser Parser to read from, used only by the parsing thread
+ * @param[in,out] stats Running statistics to update
+ * @param[in] stop_at_negative Non-zero to treat a negative value as end of input
+ * @return long long Number of values added
+ *
+ * @note Falls back to Stream_Input_Parsed() on a single thread or if the
+ *       blocks cannot be allocated
+ * @see Stream_Input_Parsed(), Stream_Stats_Merge()
+ */
+long long Pipeline_Input(Int_Parser* parser, Stream_Statistics* stats, int stop_at_negative) {
+    int tasks = Parallel_Thread_Count();
+
+    if (tasks > PIPELINE_MAX_WORKERS + 1) {
+        tasks = PIPELINE_MAX_WORKERS + 1;
+    }
+    if (tasks <= 1) {
+        return Stream_Input_Parsed(parser, stats, stop_at_negative);
+    }
+
+    Arena* arena = Scratch_Arena();
+    Arena_Mark mark = Arena_Save(arena);
+    Ring_Slot* slots = Arena_Alloc(arena, PIPELINE_SLOTS * sizeof(Ring_Slot));
+    int* values = Arena_Alloc(arena, (size_t)PIPELINE_SLOTS * PIPELINE_BLOCK_VALUES * sizeof(int));
+    Stream_Statistics* partials = Arena_Alloc(arena, (size_t)tasks * sizeof(Stream_Statistics));
+    Quantile_Sketch* sketches = NULL;
+
+    if (stats->sketch != NULL) {
+        sketches = Arena_Alloc(arena, (size_t)tasks * sizeof(Quantile_Sketch));
+    }
+    if (slots == NULL || values == NULL || partials == NULL || (stats->sketch != NULL && sketches == NULL)) {
+        Arena_Restore(arena, mark);
+        return Stream_Input_Parsed(parser, stats, stop_at_negative);
+    }
+
+    Pipeline_Job job;
+    job.ring.slots = slots;
+    job.ring.head = 0;
+    job.ring.tail = 0;
+    job.ring.finished = 0;
+    job.parser = parser;
+    job.stop_at_negative = stop_at_negative;
+    job.partials = partials;
+    job.added = 0;
+    for (int s = 0; s < PIPELINE_SLOTS; s++) {
+        slots[s].sequence = s;
+        slots[s].count = 0;
+        slots[s].values = values + (size_t)s * PIPELINE_BLOCK_VALUES;
+    }
+    for (int t = 0; t < tasks; t++) {
+        Stream_Stats_Init(&partials[t]);
+        if (sketches != NULL) {
+            Quantile_Sketch_Init(&sketches[t], RNG_DEFAULT_SEED + (uint64_t)t); /**< Independent coin flips per task */
+            partials[t].sketch = &sketches[t];
+        }
+    }
+
+    Parallel_Run(tasks, Pipeline_Task, &job);
+
+    for (int t = 0; t < tasks; t++) {
+        Stream_Stats_Merge(stats, &partials[t]);
+    }
+    Arena_Restore(arena, mark);
+    return job.added;
+}
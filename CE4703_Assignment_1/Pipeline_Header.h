@@ -0,0 +1,14 @@
+#ifndef PIPELINE_HEADER_H
+#define PIPELINE_HEADER_H // include guard
+
+#include "Parse_Operations_Header.h" // Int_Parser
+#include "Stream_Operations_Header.h" // Stream_Statistics
+
+#define PIPELINE_BLOCK_VALUES 4096 // values the parser packs into one block before handing it on
+#define PIPELINE_SLOTS 64 // blocks in the ring (a power of two), bounds how far the parser can run ahead
+#define PIPELINE_MAX_WORKERS 8 // statistics threads beside the parser, more only wait for blocks
+#define PIPELINE_SPINS 64 // yields an idle thread makes before it starts sleeping
+
+long long Pipeline_Input(Int_Parser* parser, Stream_Statistics* stats, int stop_at_negative); // same as Stream_Input_Parsed() with parsing and statistics on separate threads, returns the number of values added
+
+#endif // PIPELINE_HEADER_H
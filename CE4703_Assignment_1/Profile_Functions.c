@@ -0,0 +1,193 @@
+/**
+ * @file Profile_Functions.c
+ * @brief Per-function call counters and timers for profiling builds
+ *
+ * When CE4703_PROFILE is defined the public Simple, Matrice and Maths
+ * functions time themselves with PROFILE_ENTER()/PROFILE_EXIT() and the
+ * sort and random engines bump event counters. Totals are kept per
+ * thread and printed to stderr at exit, or on SIGUSR1 where the platform
+ * has it. Timestamps are CPU cycles from rdtsc on x86 and nanoseconds
+ * from timespec_get() elsewhere.
+ */
+
+#include "Profile_Header.h" // linking the header definitions
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <intrin.h>
+#define PROFILE_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILE_THREAD_LOCAL _Thread_local
+#endif
+#if defined(_M_X64) || defined(_M_IX86)
+#define PROFILE_CYCLES 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILE_CYCLES 1
+#else
+#define PROFILE_CYCLES 0
+#endif
+
+static const char* probe_names[PROBE_COUNT] = {
+    "Random_int", "Keyboard_Input", "Array_Random", "Print_Used", "Print_All",
+    "Find_Min", "Find_Max", "Num_of_Used_Elements", "Clear_Array", "Sort_Array",
+    "Shuffle_Array", "Array_Stats", "Mean_Average", "Median_Average", "Array_Nth",
+    "Variance", "Standard_Deviation", "Array_Percentile", "Mode_Value", "Distinct_Count",
+    "Sort_Array_h", "Array_Stats_h", "Find_Min_h", "Find_Max_h", "Mean_Average_h", "Median_Average_h",
+    "Array_Nth_h", "Variance_h", "Standard_Deviation_h"
+}; /**< Report names, in Profile_Probe order */
+
+static const char* counter_names[COUNTER_COUNT] = {
+    "sort comparisons", "sort swaps", "sort radix passes", "rng draws"
+}; /**< Report names, in Profile_Counter order */
+
+static PROFILE_THREAD_LOCAL Profile_Block* thread_block = NULL; /**< Block of the calling thread */
+static Profile_Block* volatile registered_blocks = NULL; /**< Every thread's block, newest first */
+static volatile sig_atomic_t report_requested = 0; /**< Set by the SIGUSR1 handler */
+
+#if defined(SIGUSR1)
+ /**
+  * @brief Asks for a report; printing happens at the next probe exit
+  *
+  * stdio is not async-signal-safe, so the handler only sets a flag.
+  */
+static void Request_Report(int signal_number) {
+    (void)signal_number;
+    report_requested = 1;
+}
+#endif
+
+/**
+ * @brief Pushes a block onto the shared list without a lock
+ *
+ * @param[in] block Block to publish
+ * @return int Non-zero if this was the first block registered
+ */
+static int Publish_Block(Profile_Block* block) {
+    Profile_Block* head;
+
+    do {
+        head = registered_blocks;
+        block->next = head;
+#if defined(_MSC_VER)
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&registered_blocks, block, head) != head);
+#else
+    } while (!__atomic_compare_exchange_n(&registered_blocks, &head, block, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#endif
+    return head == NULL;
+}
+
+/**
+ * @brief Returns the current timestamp
+ *
+ * @return Profile_Tick CPU cycles on x86, nanoseconds elsewhere
+ */
+Profile_Tick Profile_Now(void) {
+#if PROFILE_CYCLES
+    return (Profile_Tick)__rdtsc();
+#else
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (Profile_Tick)now.tv_sec * 1000000000u + (Profile_Tick)now.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Returns the block of the calling thread
+ *
+ * The first call on a thread allocates the block and publishes it for
+ * the report. The very first registration also installs the exit and
+ * SIGUSR1 report hooks.
+ *
+ * @return Profile_Block* Block owned by the calling thread
+ */
+Profile_Block* Profile_Thread_Block(void) {
+    static Profile_Block fallback; /**< Shared by threads that could not allocate a block */
+
+    if (thread_block != NULL) {
+        return thread_block;
+    }
+    thread_block = calloc(1, sizeof(Profile_Block));
+    if (thread_block == NULL) {
+        thread_block = &fallback;
+        return thread_block;
+    }
+    if (Publish_Block(thread_block)) {
+        atexit(Profile_Report);
+#if defined(SIGUSR1)
+        signal(SIGUSR1, Request_Report);
+#endif
+    }
+    return thread_block;
+}
+
+/**
+ * @brief Records one completed call of a probed function
+ *
+ * @param[in] probe Function that finished
+ * @param[in] elements Number of elements it processed
+ * @param[in] start Timestamp taken by PROFILE_ENTER()
+ *
+ * @return void
+ */
+void Profile_Record(Profile_Probe probe, uint64_t elements, Profile_Tick start) {
+    Profile_Tick elapsed = Profile_Now() - start;
+    Profile_Block* block = Profile_Thread_Block();
+
+    block->calls[probe]++;
+    block->elements[probe] += elements;
+    block->total_ticks[probe] += elapsed;
+    if (elapsed > block->max_ticks[probe]) {
+        block->max_ticks[probe] = elapsed;
+    }
+    if (report_requested) {
+        report_requested = 0;
+        Profile_Report();
+    }
+}
+
+/**
+ * @brief Prints the totals of every thread to stderr
+ *
+ * Times are inclusive, so a function that calls another probed function
+ * (Variance() calls Array_Stats(), for example) includes its time.
+ *
+ * @return void
+ */
+void Profile_Report(void) {
+    Profile_Block total = { { 0 }, { 0 }, { 0 }, { 0 }, { 0 }, NULL };
+    const char* unit = PROFILE_CYCLES ? "cycles" : "ns";
+
+    for (Profile_Block* block = registered_blocks; block != NULL; block = block->next) {
+        for (int p = 0; p < PROBE_COUNT; p++) {
+            total.calls[p] += block->calls[p];
+            total.elements[p] += block->elements[p];
+            total.total_ticks[p] += block->total_ticks[p];
+            if (block->max_ticks[p] > total.max_ticks[p]) {
+                total.max_ticks[p] = block->max_ticks[p];
+            }
+        }
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            total.counters[c] += block->counters[c];
+        }
+    }
+
+    fprintf(stderr, "\n----------------------------- Profile (%s) -----------------------------\n", unit);
+    fprintf(stderr, "%-22s %12s %14s %16s %14s %14s\n", "function", "calls", "elements", "total", "per element", "max");
+    for (int p = 0; p < PROBE_COUNT; p++) {
+        if (total.calls[p] == 0) {
+            continue;
+        }
+        fprintf(stderr, "%-22s %12llu %14llu %16llu %14.2f %14llu\n", probe_names[p],
+            (unsigned long long)total.calls[p], (unsigned long long)total.elements[p],
+            (unsigned long long)total.total_ticks[p],
+            total.elements[p] ? (double)total.total_ticks[p] / (double)total.elements[p] : 0.0,
+            (unsigned long long)total.max_ticks[p]);
+    }
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        fprintf(stderr, "%-22s %12llu\n", counter_names[c], (unsigned long long)total.counters[c]);
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef PROFILE_HEADER_H
+#define PROFILE_HEADER_H // include guard
+
+// Hot-path instrumentation, compiled in only when CE4703_PROFILE is defined
+// (add it to the preprocessor definitions of the project). Without the flag
+// every PROFILE_ macro expands to nothing, so the probes cost nothing.
+
+#include <stdint.h>
+
+/**
+ * @brief Probed functions, one timer each
+ */
+typedef enum Profile_Probe {
+    PROBE_RANDOM_INT,
+    PROBE_KEYBOARD_INPUT,
+    PROBE_ARRAY_RANDOM,
+    PROBE_PRINT_USED,
+    PROBE_PRINT_ALL,
+    PROBE_FIND_MIN,
+    PROBE_FIND_MAX,
+    PROBE_NUM_OF_USED_ELEMENTS,
+    PROBE_CLEAR_ARRAY,
+    PROBE_SORT_ARRAY,
+    PROBE_SHUFFLE_ARRAY,
+    PROBE_ARRAY_STATS,
+    PROBE_MEAN_AVERAGE,
+    PROBE_MEDIAN_AVERAGE,
+    PROBE_ARRAY_NTH,
+    PROBE_VARIANCE,
+    PROBE_STANDARD_DEVIATION,
+    PROBE_ARRAY_PERCENTILE,
+    PROBE_MODE_VALUE,
+    PROBE_DISTINCT_COUNT,
+    PROBE_SORT_ARRAY_H, // IntArray handle variants, called by MF1 and MF3
+    PROBE_ARRAY_STATS_H,
+    PROBE_FIND_MIN_H,
+    PROBE_FIND_MAX_H,
+    PROBE_MEAN_AVERAGE_H,
+    PROBE_MEDIAN_AVERAGE_H,
+    PROBE_ARRAY_NTH_H,
+    PROBE_VARIANCE_H,
+    PROBE_STANDARD_DEVIATION_H,
+    PROBE_COUNT // number of probes, not a probe
+} Profile_Probe;
+
+/**
+ * @brief Event counters that are not tied to one call
+ */
+typedef enum Profile_Counter {
+    COUNTER_SORT_COMPARISONS, // element comparisons in the comparison sorts and merges
+    COUNTER_SORT_SWAPS, // element exchanges and insertion shifts
+    COUNTER_SORT_RADIX_PASSES, // radix passes that moved data (radix sort does no comparisons)
+    COUNTER_RNG_DRAWS, // random numbers drawn by Random_int() and Array_Random()
+    COUNTER_COUNT // number of counters, not a counter
+} Profile_Counter;
+
+typedef uint64_t Profile_Tick; // timestamp in cycles (rdtsc) or nanoseconds
+
+/**
+ * @brief Per-thread probe and counter totals
+ *
+ * Each thread writes only its own block, so recording needs no atomics;
+ * the report adds the blocks of every thread together.
+ */
+typedef struct Profile_Block {
+    uint64_t calls[PROBE_COUNT]; // completed calls per probe
+    uint64_t elements[PROBE_COUNT]; // elements processed per probe
+    uint64_t total_ticks[PROBE_COUNT]; // inclusive time per probe
+    uint64_t max_ticks[PROBE_COUNT]; // longest single call per probe
+    uint64_t counters[COUNTER_COUNT]; // event counters
+    struct Profile_Block* next; // next registered thread
+} Profile_Block;
+
+Profile_Tick Profile_Now(void); // current timestamp
+Profile_Block* Profile_Thread_Block(void); // block of the calling thread, registered on first use
+void Profile_Record(Profile_Probe probe, uint64_t elements, Profile_Tick start); // records one completed call
+void Profile_Report(void); // prints the totals of every thread to stderr
+
+#if defined(CE4703_PROFILE)
+#define PROFILE_ENTER() Profile_Tick profile_start = Profile_Now() // starts the timer of the enclosing function
+#define PROFILE_EXIT(probe, elements) Profile_Record((probe), (uint64_t)(elements), profile_start) // records the call, place before every return
+#define PROFILE_COUNT(counter, amount) (Profile_Thread_Block()->counters[(counter)] += (uint64_t)(amount)) // adds to an event counter
+#else
+#define PROFILE_ENTER() ((void)0)
+#define PROFILE_EXIT(probe, elements) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif // PROFILE_HEADER_H
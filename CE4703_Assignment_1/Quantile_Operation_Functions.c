@@ -0,0 +1,419 @@
+/**
+ * @file Quantile_Operation_Functions.c
+ * @brief Batched quantile queries, exact and streaming-approximate
+ *
+ * Array_Quantiles() answers several percentiles of an array in one call:
+ * a count table when the value range is small, otherwise one multi-select
+ * that partitions the data once for all requested ranks. For streams too
+ * long to keep, Quantile_Sketch is a KLL sketch with fixed memory that can
+ * be fed value by value and merged across threads.
+ */
+
+#include "Quantile_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include "Sort_Operations_Header.h" // linking introsort for small ranges
+#include "Histogram_Operations_Header.h" // linking the count-table engine
+#include "Arena_Header.h" // linking the scratch arena
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MULTI_SELECT_SORT_THRESHOLD 32 // ranges this small are sorted outright
+
+/**
+ * @brief Converts a percentile to a zero-based nearest rank
+ *
+ * @param[in] percentile Percentile, clamped to [0, 100]
+ * @param[in] count Number of values, at least 1
+ * @return long long Rank of the smallest value with at least percentile% of the values at or below it
+ */
+static long long Nearest_Rank(double percentile, long long count) {
+    double rank = ceil(percentile / 100.0 * (double)count); /**< One-based nearest rank */
+
+    if (rank < 1.0) {
+        return 0;
+    }
+    if (rank > (double)count) {
+        return count - 1;
+    }
+    return (long long)rank - 1;
+}
+
+/**
+ * @brief Places every requested rank of a range at its sorted position
+ *
+ * Partitions the range once around a median-of-three pivot into
+ * < pivot | == pivot | > pivot, splits the sorted rank list at the same
+ * boundaries and continues only into sides that still hold ranks. Ranges
+ * that are small, or too deep, are finished with introsort.
+ *
+ * @param[in,out] data Buffer being selected
+ * @param[in] low First index of the range (inclusive)
+ * @param[in] high Last index of the range (inclusive)
+ * @param[in] ranks Requested ranks in ascending order
+ * @param[in] first First rank inside the range
+ * @param[in] last Last rank inside the range
+ * @param[in] depth_limit Remaining partition levels before introsort is used
+ */
+static void Multi_Select(int data[], int low, int high, const int ranks[], int first, int last, int depth_limit) {
+    while (first <= last && high > low) {
+        if (high - low + 1 <= MULTI_SELECT_SORT_THRESHOLD || depth_limit-- == 0) {
+            Intro_Sort(data + low, high - low + 1);
+            return;
+        }
+
+        int mid = low + (high - low) / 2;
+        int a = data[low], b = data[mid], c = data[high];
+        int pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+                            : ((a < c) ? a : ((b < c) ? c : b));
+
+        /* Three-way partition into < pivot | == pivot | > pivot */
+        int less = low;
+        int i = low;
+        int greater = high;
+        while (i <= greater) {
+            int value = data[i];
+            if (value < pivot) {
+                data[i++] = data[less];
+                data[less++] = value;
+            }
+            else if (value > pivot) {
+                data[i] = data[greater];
+                data[greater--] = value;
+            }
+            else {
+                i++;
+            }
+        }
+
+        /* Ranks in [less, greater] already hold the pivot */
+        int left_last = first - 1;
+        while (left_last < last && ranks[left_last + 1] < less) {
+            left_last++;
+        }
+        int right_first = left_last + 1;
+        while (right_first <= last && ranks[right_first] <= greater) {
+            right_first++;
+        }
+
+        Multi_Select(data, low, less - 1, ranks, first, left_last, depth_limit);
+        low = greater + 1;
+        first = right_first;
+    }
+}
+
+/**
+ * @brief Returns several exact percentiles of the used elements in one call
+ *
+ * Uses a count table when the values span a small range (see
+ * Histogram_Fits()). Otherwise the used elements are copied to scratch
+ * memory and one multi-select pass places every requested rank, which
+ * costs O(n log q) for q percentiles instead of q separate selections or
+ * a full sort. Percentiles use the nearest-rank method, as
+ * Array_Percentile() does.
+ *
+ * @param[in] array Array of integers to process
+ * @param[in] capacity Total number of elements in the array
+ * @param[in] percentiles Percentiles to return, each clamped to [0, 100], in any order
+ * @param[in] count Number of percentiles
+ * @param[out] results Receives one value per percentile, UNUSED_MARKER if there are no used elements
+ * @return int 0 on success, -1 if scratch memory could not be allocated
+ *
+ * @note The input array is not modified
+ *
+ * @code
+ * double tails[4] = {50.0, 90.0, 99.0, 99.9};
+ * int values[4];
+ * Array_Quantiles(latencies, capacity, tails, 4, values);
+ * @endcode
+ */
+int Array_Quantiles(int array[], int capacity, const double percentiles[], int count, int results[]) {
+    Arena* arena = Scratch_Arena();
+    Arena_Mark mark = Arena_Save(arena);
+    Histogram histogram; /**< Count table, used when the value range is small */
+    int min, max;
+    int used = Histogram_Bounds(array, capacity, &min, &max); /**< Number of used elements */
+    int status = 0;
+
+    if (used == 0) {
+        for (int q = 0; q < count; q++) {
+            results[q] = UNUSED_MARKER;
+        }
+        return 0;
+    }
+    if (Histogram_Fits(min, max, used) && Histogram_Build(&histogram, array, capacity, min, max) == 0) {
+        for (int q = 0; q < count; q++) {
+            results[q] = Histogram_Nth(&histogram, (int)Nearest_Rank(percentiles[q], used));
+        }
+        Arena_Restore(arena, mark);
+        return 0;
+    }
+
+    int* data = Arena_Alloc(arena, (size_t)used * sizeof(int)); /**< Dense copy that the selection rearranges */
+    int* ranks = Arena_Alloc(arena, (size_t)count * sizeof(int)); /**< Requested ranks in ascending order */
+    if (data == NULL || ranks == NULL) {
+        status = -1;
+    }
+    else {
+        int depth_limit = 0;
+        int filled = 0;
+        for (int i = 0; i < capacity; i++) {
+            if (IS_USED(array[i])) {
+                data[filled++] = array[i];
+            }
+        }
+        for (int q = 0; q < count; q++) {
+            ranks[q] = (int)Nearest_Rank(percentiles[q], used);
+        }
+        Intro_Sort(ranks, count);
+        for (int n = used; n > 1; n >>= 1) {
+            depth_limit += 2; /**< 2 * log2(n) levels, as in introsort */
+        }
+        Multi_Select(data, 0, used - 1, ranks, 0, count - 1, depth_limit);
+        for (int q = 0; q < count; q++) {
+            results[q] = data[Nearest_Rank(percentiles[q], used)];
+        }
+    }
+    Arena_Restore(arena, mark);
+    return status;
+}
+
+/**
+ * @brief Returns the capacity of a level
+ *
+ * The top level holds QUANTILE_SKETCH_K items and each level below it
+ * two thirds of the one above, down to QUANTILE_SKETCH_MIN_CAPACITY.
+ *
+ * @param[in] sketch Sketch to query
+ * @param[in] level Level index
+ * @return int Number of items the level may hold before it is compacted
+ */
+static int Level_Capacity(const Quantile_Sketch* sketch, int level) {
+    int capacity = QUANTILE_SKETCH_K;
+
+    for (int depth = sketch->levels - 1 - level; depth > 0 && capacity > QUANTILE_SKETCH_MIN_CAPACITY; depth--) {
+        capacity = capacity * 2 / 3;
+    }
+    return (capacity > QUANTILE_SKETCH_MIN_CAPACITY) ? capacity : QUANTILE_SKETCH_MIN_CAPACITY;
+}
+
+/**
+ * @brief Halves a level by promoting every other sorted item
+ *
+ * The level is sorted and a coin picks the even or odd positions to move
+ * up with doubled weight, so the total weight is unchanged. With an odd
+ * number of items the smallest stays behind. The top possible level is
+ * thinned in place instead, which only happens after about 2^32 * K values.
+ *
+ * @param[in,out] sketch Sketch to compact
+ * @param[in] level Level to halve
+ */
+static void Compact_Level(Quantile_Sketch* sketch, int level) {
+    int* items = sketch->items[level];
+    int size = sketch->sizes[level];
+    int keep = size % 2; /**< An odd item out stays at this level */
+    int pairs = size / 2;
+    int offset = keep + (int)(Rng_Next(&sketch->rng) & 1); /**< Coin flip: promote even or odd positions */
+
+    Intro_Sort(items, size);
+    if (level + 1 >= QUANTILE_SKETCH_LEVELS) {
+        for (int i = 0; i < pairs; i++) {
+            items[keep + i] = items[offset + 2 * i];
+        }
+        sketch->sizes[level] = keep + pairs;
+        return;
+    }
+    int* above = sketch->items[level + 1] + sketch->sizes[level + 1];
+    for (int i = 0; i < pairs; i++) {
+        above[i] = items[offset + 2 * i];
+    }
+    sketch->sizes[level + 1] += pairs;
+    sketch->sizes[level] = keep;
+    if (level + 1 == sketch->levels) {
+        sketch->levels++;
+    }
+}
+
+/**
+ * @brief Compacts every level that has reached its capacity, bottom up
+ *
+ * @param[in,out] sketch Sketch to compress
+ */
+static void Compress(Quantile_Sketch* sketch) {
+    for (int level = 0; level < sketch->levels; level++) {
+        if (sketch->sizes[level] >= Level_Capacity(sketch, level)) {
+            Compact_Level(sketch, level);
+        }
+    }
+}
+
+/**
+ * @brief Empties a sketch
+ *
+ * @param[out] sketch Sketch to initialise
+ * @param[in] seed Seed of the compaction coin flips, any fixed value gives reproducible results
+ *
+ * @return void
+ */
+void Quantile_Sketch_Init(Quantile_Sketch* sketch, uint64_t seed) {
+    memset(sketch->sizes, 0, sizeof(sketch->sizes));
+    sketch->levels = 1;
+    sketch->count = 0;
+    sketch->min = UNUSED_MARKER;
+    sketch->max = UNUSED_MARKER;
+    Rng_Seed(&sketch->rng, seed);
+}
+
+/**
+ * @brief Adds one value to the sketch
+ *
+ * @param[in,out] sketch Sketch to update
+ * @param[in] value Value to add, any int
+ *
+ * @return void
+ *
+ * @note Amortised O(log K) per value
+ */
+void Quantile_Sketch_Update(Quantile_Sketch* sketch, int value) {
+    if (sketch->count == 0 || value < sketch->min) {
+        sketch->min = value;
+    }
+    if (sketch->count == 0 || value > sketch->max) {
+        sketch->max = value;
+    }
+    sketch->count++;
+    sketch->items[0][sketch->sizes[0]++] = value;
+    if (sketch->sizes[0] >= Level_Capacity(sketch, 0)) {
+        Compress(sketch);
+    }
+}
+
+/**
+ * @brief Adds every used element of an array to the sketch
+ *
+ * @param[in,out] sketch Sketch to update
+ * @param[in] array Array of integers to add
+ * @param[in] capacity Total number of elements in the array
+ *
+ * @return void
+ */
+void Quantile_Sketch_Feed(Quantile_Sketch* sketch, const int array[], int capacity) {
+    for (int i = 0; i < capacity; i++) {
+        if (IS_USED(array[i])) {
+            Quantile_Sketch_Update(sketch, array[i]);
+        }
+    }
+}
+
+/**
+ * @brief Merges another sketch into this one
+ *
+ * Items are appended level by level, compacting a level first if the
+ * incoming items would not fit, so a thread can summarise its share of a
+ * stream and the results can be combined at the end. The error bound of
+ * the merged sketch is that of one sketch fed with all the values.
+ *
+ * @param[in,out] into Sketch receiving the values
+ * @param[in] from Sketch to add, not modified
+ *
+ * @return void
+ */
+void Quantile_Sketch_Merge(Quantile_Sketch* into, const Quantile_Sketch* from) {
+    if (from->count == 0) {
+        return;
+    }
+    if (into->count == 0 || from->min < into->min) {
+        into->min = from->min;
+    }
+    if (into->count == 0 || from->max > into->max) {
+        into->max = from->max;
+    }
+    for (int level = 0; level < from->levels; level++) {
+        if (level >= into->levels) {
+            into->levels = level + 1;
+        }
+        if (into->sizes[level] + from->sizes[level] > QUANTILE_SKETCH_SLOTS) {
+            Compact_Level(into, level); /**< Make room; the level keeps at most one item */
+        }
+        memcpy(into->items[level] + into->sizes[level], from->items[level], (size_t)from->sizes[level] * sizeof(int));
+        into->sizes[level] += from->sizes[level];
+    }
+    into->count += from->count;
+    Compress(into);
+}
+
+/**
+ * @brief Retained item and its level, for sorting during a query
+ */
+typedef struct Weighted_Item {
+    int value; // retained value
+    int level; // level it was held at, weight 2^level
+} Weighted_Item;
+
+/**
+ * @brief Orders weighted items by value for qsort()
+ */
+static int Compare_Items(const void* a, const void* b) {
+    int x = ((const Weighted_Item*)a)->value;
+    int y = ((const Weighted_Item*)b)->value;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Returns approximate percentiles of the values fed to the sketch
+ *
+ * Sorts the retained items once and walks their cumulative weights for
+ * every requested percentile. The 0th and 100th percentiles are the
+ * exact minimum and maximum.
+ *
+ * @param[in] sketch Sketch to query
+ * @param[in] percentiles Percentiles to return, each clamped to [0, 100]
+ * @param[in] count Number of percentiles
+ * @param[out] results Receives one value per percentile
+ * @return int 0 on success, -1 if the sketch is empty or scratch memory could not be allocated
+ */
+int Quantile_Sketch_Query(const Quantile_Sketch* sketch, const double percentiles[], int count, int results[]) {
+    Arena* arena = Scratch_Arena();
+    Arena_Mark mark = Arena_Save(arena);
+    int retained = 0; /**< Items held over all levels */
+    long long total = 0; /**< Sum of the item weights */
+
+    if (sketch->count == 0) {
+        return -1;
+    }
+    for (int level = 0; level < sketch->levels; level++) {
+        retained += sketch->sizes[level];
+    }
+    Weighted_Item* items = Arena_Alloc(arena, (size_t)retained * sizeof(Weighted_Item));
+    if (items == NULL) {
+        return -1;
+    }
+    for (int level = 0, position = 0; level < sketch->levels; level++) {
+        for (int i = 0; i < sketch->sizes[level]; i++) {
+            items[position].value = sketch->items[level][i];
+            items[position++].level = level;
+        }
+        total += (long long)sketch->sizes[level] << level;
+    }
+    qsort(items, (size_t)retained, sizeof(Weighted_Item), Compare_Items);
+
+    for (int q = 0; q < count; q++) {
+        if (percentiles[q] <= 0.0) {
+            results[q] = sketch->min;
+            continue;
+        }
+        if (percentiles[q] >= 100.0) {
+            results[q] = sketch->max;
+            continue;
+        }
+        long long rank = Nearest_Rank(percentiles[q], total); /**< Zero-based target rank in item weight */
+        long long seen = 0;
+        int i = 0;
+        while (i < retained - 1 && (seen += (long long)1 << items[i].level) <= rank) {
+            i++;
+        }
+        results[q] = items[i].value;
+    }
+    Arena_Restore(arena, mark);
+    return 0;
+}
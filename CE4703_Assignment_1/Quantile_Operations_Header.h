@@ -0,0 +1,39 @@
+#ifndef QUANTILE_OPERATIONS_HEADER_H
+#define QUANTILE_OPERATIONS_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+#include "Random_Engine_Header.h" // Rng_State for the compaction coin flips
+
+#define QUANTILE_SKETCH_K 200 // accuracy of the sketch, rank error is about 1.3% of the count at 200 and shrinks as 1 / K
+#define QUANTILE_SKETCH_LEVELS 32 // compaction levels, enough for about 2^32 * K values
+#define QUANTILE_SKETCH_SLOTS (3 * QUANTILE_SKETCH_K) // storage per level, room for a merge before compaction
+#define QUANTILE_SKETCH_MIN_CAPACITY 8 // smallest capacity of a low level
+
+/**
+ * @brief Mergeable approximate quantile sketch (KLL)
+ *
+ * Values enter level 0 with weight 1. When a level reaches its capacity
+ * it is sorted and every other item, chosen by a fair coin, moves up one
+ * level with twice the weight. Capacities shrink by 2/3 per level below
+ * the top. The storage is a fixed 32 levels of 600 ints, about 77 KB per
+ * sketch, however long the stream is.
+ * Two sketches fed by different threads can be merged into one.
+ */
+typedef struct Quantile_Sketch {
+    int items[QUANTILE_SKETCH_LEVELS][QUANTILE_SKETCH_SLOTS]; // retained values, items at level h weigh 2^h
+    int sizes[QUANTILE_SKETCH_LEVELS]; // number of items held at each level
+    int levels; // levels in use, at least 1
+    long long count; // number of values fed
+    int min; // smallest value fed, exact
+    int max; // largest value fed, exact
+    Rng_State rng; // source of the compaction coin flips
+} Quantile_Sketch;
+
+int Array_Quantiles(int array[], int capacity, const double percentiles[], int count, int results[]); // exact nearest-rank percentiles of the used elements in one multi-select, returns 0 or -1 if out of memory
+void Quantile_Sketch_Init(Quantile_Sketch* sketch, uint64_t seed); // empties the sketch
+void Quantile_Sketch_Update(Quantile_Sketch* sketch, int value); // adds one value
+void Quantile_Sketch_Feed(Quantile_Sketch* sketch, const int array[], int capacity); // adds every used element of an array
+void Quantile_Sketch_Merge(Quantile_Sketch* into, const Quantile_Sketch* from); // adds the values summarised by another sketch
+int Quantile_Sketch_Query(const Quantile_Sketch* sketch, const double percentiles[], int count, int results[]); // approximate percentiles, returns 0 or -1 if empty or out of memory
+
+#endif // QUANTILE_OPERATIONS_HEADER_H
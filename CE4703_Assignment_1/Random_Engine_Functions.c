@@ -0,0 +1,193 @@
+/**
+ * @file Random_Engine_Functions.c
+ * @brief Implementation of the xoshiro256** random number engine
+ *
+ * This file provides a seedable generator with its own state object,
+ * unbiased bounded sampling using Lemire's nearly-divisionless method,
+ * and a bulk fill path that draws two 32-bit samples from every 64-bit
+ * output. Random_int() and Array_Random() run on a shared instance.
+ */
+
+#include "Random_Engine_Header.h" // linking the header definitions
+
+static Rng_State default_state; /**< Shared generator behind Random_int() */
+static int default_seeded = 0; /**< Set once default_state has been seeded */
+
+ /**
+  * @brief Rotates a 64-bit word left
+  *
+  * @param[in] x Word to rotate
+  * @param[in] k Number of bits, 0 < k < 64
+  * @return uint64_t Rotated word
+  */
+static uint64_t Rotate_Left(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Initialises a generator from a 64-bit seed
+ *
+ * Expands the seed with SplitMix64 so that similar seeds still produce
+ * unrelated states and the state is never all zero.
+ *
+ * @param[out] state Generator to initialise
+ * @param[in] seed Any 64-bit value; equal seeds give equal sequences
+ *
+ * @return void
+ */
+void Rng_Seed(Rng_State* state, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        state->s[i] = z ^ (z >> 31);
+    }
+}
+
+/**
+ * @brief Returns the next 64 random bits (xoshiro256**)
+ *
+ * @param[in,out] state Generator to advance
+ * @return uint64_t Uniformly distributed 64-bit value
+ */
+uint64_t Rng_Next(Rng_State* state) {
+    uint64_t* s = state->s;
+    uint64_t result = Rotate_Left(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Rotate_Left(s[3], 45);
+    return result;
+}
+
+/**
+ * @brief Maps a 32-bit random value into [0, range) without bias
+ *
+ * Lemire's method: the high half of x * range is the result, and a
+ * division is only needed in the rare case the low half falls in the
+ * biased zone, which triggers a redraw.
+ *
+ * @param[in,out] state Generator used for redraws
+ * @param[in] x First 32-bit random value
+ * @param[in] range Size of the interval, must be greater than 0
+ * @return uint32_t Random number in [0, range)
+ */
+static uint32_t Lemire_Reduce(Rng_State* state, uint32_t x, uint32_t range) {
+    uint64_t product = (uint64_t)x * range;
+    uint32_t low = (uint32_t)product;
+
+    if (low < range) {
+        uint32_t threshold = (uint32_t)(0u - range) % range; /**< 2^32 mod range */
+        while (low < threshold) {
+            x = (uint32_t)(Rng_Next(state) >> 32);
+            product = (uint64_t)x * range;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+/**
+ * @brief Returns an unbiased random number in [0, range)
+ *
+ * @param[in,out] state Generator to draw from
+ * @param[in] range Size of the interval, must be greater than 0
+ * @return uint32_t Random number in [0, range)
+ */
+uint32_t Rng_Bounded(Rng_State* state, uint32_t range) {
+    return Lemire_Reduce(state, (uint32_t)(Rng_Next(state) >> 32), range);
+}
+
+/**
+ * @brief Returns an unbiased random number in [min, max]
+ *
+ * @param[in,out] state Generator to draw from
+ * @param[in] min Minimum value of range (inclusive)
+ * @param[in] max Maximum value of range (inclusive)
+ * @return int Random integer in the range [min, max]
+ *
+ * @warning Max must be greater than or equal to min
+ */
+int Rng_Range(Rng_State* state, int min, int max) {
+    uint64_t span = (uint64_t)((int64_t)max - min) + 1; /**< Number of possible results, up to 2^32 */
+
+    if (span > UINT32_MAX) {
+        return (int)(uint32_t)(Rng_Next(state) >> 32); /**< Full int range: every 32-bit pattern is valid */
+    }
+    return (int)((int64_t)min + Lemire_Reduce(state, (uint32_t)(Rng_Next(state) >> 32), (uint32_t)span));
+}
+
+/**
+ * @brief Fills an array with unbiased random numbers in [min, max]
+ *
+ * Draws two 32-bit samples from every 64-bit generator output and keeps
+ * the generator state in locals for the whole block, which is several
+ * times faster than calling Rng_Range() per element.
+ *
+ * @param[in,out] state Generator to draw from
+ * @param[out] array Array to fill
+ * @param[in] count Number of elements to fill
+ * @param[in] min Minimum value (inclusive)
+ * @param[in] max Maximum value (inclusive)
+ *
+ * @return void
+ *
+ * @warning Max must be greater than or equal to min
+ */
+void Rng_Fill_Range(Rng_State* state, int array[], int count, int min, int max) {
+    uint64_t span = (uint64_t)((int64_t)max - min) + 1; /**< Number of possible results, up to 2^32 */
+    uint32_t range = (uint32_t)span;
+    uint32_t threshold = (span > UINT32_MAX) ? 0 : (uint32_t)(0u - range) % range; /**< Values of low below this are biased */
+    Rng_State local = *state; /**< Working copy kept in registers */
+    int i = 0;
+
+    while (i < count) {
+        uint64_t bits = Rng_Next(&local);
+        uint32_t halves[2] = { (uint32_t)(bits >> 32), (uint32_t)bits };
+
+        for (int h = 0; h < 2 && i < count; h++) {
+            if (span > UINT32_MAX) {
+                array[i++] = (int)halves[h];
+                continue;
+            }
+            uint64_t product = (uint64_t)halves[h] * range;
+            if ((uint32_t)product < threshold) {
+                continue; /**< Rejected sample, draw again */
+            }
+            array[i++] = (int)((int64_t)min + (uint32_t)(product >> 32));
+        }
+    }
+    *state = local;
+}
+
+/**
+ * @brief Returns the shared generator, seeding it on first use
+ *
+ * The shared generator starts from RNG_DEFAULT_SEED, so a run that never
+ * calls Random_Seed() is reproducible, as with an unseeded rand().
+ *
+ * @return Rng_State* Shared generator
+ */
+Rng_State* Rng_Default(void) {
+    if (!default_seeded) {
+        Rng_Seed(&default_state, RNG_DEFAULT_SEED);
+        default_seeded = 1;
+    }
+    return &default_state;
+}
+
+/**
+ * @brief Reseeds the shared generator
+ *
+ * @param[in] seed Any 64-bit value
+ *
+ * @return void
+ */
+void Random_Seed(uint64_t seed) {
+    Rng_Seed(&default_state, seed);
+    default_seeded = 1;
+}
@@ -0,0 +1,26 @@
+#ifndef RANDOM_ENGINE_HEADER_H
+#define RANDOM_ENGINE_HEADER_H // include guard
+
+#include <stdint.h>
+
+#define RNG_DEFAULT_SEED 0x4345343730334131ULL // seed of the shared generator until Random_Seed() is called
+
+/**
+ * @brief State of a xoshiro256** pseudo-random generator
+ *
+ * Each generator owns its state, so independent streams (for example one
+ * per thread) do not interfere. Must be seeded with Rng_Seed() before use.
+ */
+typedef struct Rng_State {
+    uint64_t s[4]; // 256-bit generator state, never all zero
+} Rng_State;
+
+void Rng_Seed(Rng_State* state, uint64_t seed); // initialises a generator from a 64-bit seed
+uint64_t Rng_Next(Rng_State* state); // returns the next 64 random bits
+uint32_t Rng_Bounded(Rng_State* state, uint32_t range); // unbiased random number in [0, range), range > 0
+int Rng_Range(Rng_State* state, int min, int max); // unbiased random number in [min, max]
+void Rng_Fill_Range(Rng_State* state, int array[], int count, int min, int max); // fills count elements with unbiased random numbers in [min, max]
+Rng_State* Rng_Default(void); // shared generator used by Random_int() and Array_Random()
+void Random_Seed(uint64_t seed); // reseeds the shared generator
+
+#endif // RANDOM_ENGINE_HEADER_H
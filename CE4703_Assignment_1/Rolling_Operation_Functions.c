@@ -0,0 +1,256 @@
+/**
+ * @file Rolling_Operation_Functions.c
+ * @brief Moving mean, variance, min and max over a sliding window
+ *
+ * Recomputing Mean_Average() and Variance() for every window position
+ * costs O(n * W). A Rolling_Window keeps the window's statistics up to
+ * date as values arrive and leave, at O(1) amortized per value, and can
+ * report them after every value or every k-th value, for monitoring a
+ * live feed or smoothing an array.
+ */
+
+#include "Rolling_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+
+/**
+ * @brief Recomputes the sum of squares around the current mean
+ *
+ * Adding and removing squares is exact while the sum stays below 2^53,
+ * and the shift keeps the squares small while the data stays near it.
+ * Once per window length the shift is moved to the current mean and the
+ * sum is rebuilt from the ring, so neither rounding nor a drifting level
+ * can build up; the O(W) rebuild every W values keeps pushes O(1)
+ * amortized.
+ *
+ * @param[in,out] window Window to rebase
+ */
+static void Rolling_Rebase(Rolling_Window* window) {
+    int count = (window->pushed < window->size) ? (int)window->pushed : window->size;
+    double sum_squares = 0.0;
+
+    window->shift = (count > 0) ? (int)(window->sum / count) : 0;
+    for (int i = 0; i < count; i++) {
+        double deviation = (double)window->values[i] - window->shift;
+        sum_squares += deviation * deviation;
+    }
+    window->sum_squares = sum_squares;
+}
+
+/**
+ * @brief Allocates and empties a rolling window
+ *
+ * @param[out] window Window to set up
+ * @param[in] size Number of values in the window, at least 1
+ * @param[in] every Emit a result for every every-th value pushed, 1 for every value
+ * @return int 0 on success, -1 if size or every is below 1 or out of memory
+ */
+int Rolling_Window_Init(Rolling_Window* window, int size, int every) {
+    window->values = NULL;
+    window->min_deque = NULL;
+    window->max_deque = NULL;
+    if (size < 1 || every < 1) {
+        return -1;
+    }
+    window->values = malloc((size_t)size * sizeof(int));
+    window->min_deque = malloc((size_t)size * sizeof(Rolling_Entry));
+    window->max_deque = malloc((size_t)size * sizeof(Rolling_Entry));
+    if (window->values == NULL || window->min_deque == NULL || window->max_deque == NULL) {
+        Rolling_Window_Free(window);
+        return -1;
+    }
+    window->size = size;
+    window->every = every;
+    Rolling_Window_Reset(window);
+    return 0;
+}
+
+/**
+ * @brief Empties a window, keeping its size, period and rings
+ *
+ * @param[in,out] window Window to empty
+ *
+ * @return void
+ */
+void Rolling_Window_Reset(Rolling_Window* window) {
+    window->min_front = 0;
+    window->min_length = 0;
+    window->max_front = 0;
+    window->max_length = 0;
+    window->pushed = 0;
+    window->sum = 0;
+    window->shift = 0;
+    window->sum_squares = 0.0;
+}
+
+/**
+ * @brief Releases the rings of a window
+ *
+ * @param[in,out] window Window to release, safe to call twice
+ *
+ * @return void
+ */
+void Rolling_Window_Free(Rolling_Window* window) {
+    free(window->values);
+    free(window->min_deque);
+    free(window->max_deque);
+    window->values = NULL;
+    window->min_deque = NULL;
+    window->max_deque = NULL;
+}
+
+/**
+ * @brief Adds a value to the window and drops the one that falls out
+ *
+ * @param[in,out] window Window to update
+ * @param[in] value New value, any int
+ * @param[out] result Filled with the window statistics when a result is due, may be NULL
+ * @return int 1 if this is an every-th value and result was filled, 0 otherwise
+ *
+ * @note O(1) amortized: each value is pushed onto and popped off each deque at most once
+ */
+int Rolling_Window_Push(Rolling_Window* window, int value, Rolling_Result* result) {
+    int size = window->size;
+    long long position = window->pushed;
+    int slot = (int)(position % size); /**< Ring slot of the new value, also of the value leaving */
+
+    /* The first value is the shift until the first rebase, as in Array_Stats() */
+    if (position == 0) {
+        window->shift = value;
+    }
+    /* Replace the oldest value once the window is full */
+    else if (position >= size) {
+        int leaving = window->values[slot];
+        double deviation = (double)leaving - window->shift;
+        window->sum -= leaving;
+        window->sum_squares -= deviation * deviation;
+    }
+    window->values[slot] = value;
+    window->sum += value;
+    double deviation = (double)value - window->shift;
+    window->sum_squares += deviation * deviation;
+    window->pushed++;
+
+    /* Min deque: drop expired front, then larger-or-equal values from the back */
+    if (window->min_length > 0 && window->min_deque[window->min_front].position <= position - size) {
+        window->min_front = (window->min_front + 1 == size) ? 0 : window->min_front + 1;
+        window->min_length--;
+    }
+    while (window->min_length > 0) {
+        int back = window->min_front + window->min_length - 1;
+        back -= (back >= size) ? size : 0;
+        if (window->min_deque[back].value < value) {
+            break;
+        }
+        window->min_length--;
+    }
+    int min_slot = window->min_front + window->min_length;
+    min_slot -= (min_slot >= size) ? size : 0;
+    window->min_deque[min_slot].position = position;
+    window->min_deque[min_slot].value = value;
+    window->min_length++;
+
+    /* Max deque: the same with the comparison reversed */
+    if (window->max_length > 0 && window->max_deque[window->max_front].position <= position - size) {
+        window->max_front = (window->max_front + 1 == size) ? 0 : window->max_front + 1;
+        window->max_length--;
+    }
+    while (window->max_length > 0) {
+        int back = window->max_front + window->max_length - 1;
+        back -= (back >= size) ? size : 0;
+        if (window->max_deque[back].value > value) {
+            break;
+        }
+        window->max_length--;
+    }
+    int max_slot = window->max_front + window->max_length;
+    max_slot -= (max_slot >= size) ? size : 0;
+    window->max_deque[max_slot].position = position;
+    window->max_deque[max_slot].value = value;
+    window->max_length++;
+
+    if (window->pushed % size == 0) {
+        Rolling_Rebase(window);
+    }
+
+    if (window->pushed % window->every != 0) {
+        return 0;
+    }
+    if (result != NULL) {
+        Rolling_Window_Current(window, result);
+    }
+    return 1;
+}
+
+/**
+ * @brief Reads the statistics of the window as it is now
+ *
+ * Uses the same variance formula as Stats_From_Moments(), so a full window
+ * gives the values Array_Stats() would give for the same elements.
+ *
+ * @param[in] window Window to read
+ * @param[out] result Statistics of the window; count is 0 and min and max are UNUSED_MARKER before the first value
+ *
+ * @return void
+ */
+void Rolling_Window_Current(const Rolling_Window* window, Rolling_Result* result) {
+    int count = (window->pushed < window->size) ? (int)window->pushed : window->size;
+
+    result->position = window->pushed - 1;
+    result->count = count;
+    if (count == 0) {
+        result->min = UNUSED_MARKER;
+        result->max = UNUSED_MARKER;
+        result->mean = 0.0;
+        result->variance = 0.0;
+        result->standard_deviation = 0.0;
+        return;
+    }
+
+    double shifted_sum = (double)(window->sum - (long long)count * window->shift); /**< Sum of deviations from the shift */
+    double variance = (window->sum_squares - shifted_sum * shifted_sum / count) / count;
+    if (variance < 0.0) {
+        variance = 0.0; /**< Guard against rounding just below zero */
+    }
+    result->min = window->min_deque[window->min_front].value;
+    result->max = window->max_deque[window->max_front].value;
+    result->mean = (double)window->sum / count;
+    result->variance = variance;
+    result->standard_deviation = sqrt(variance);
+}
+
+/**
+ * @brief Computes rolling statistics over the used elements of an array
+ *
+ * The used elements are taken in order as a stream; unused elements are
+ * skipped and do not count toward the window. A result is written for
+ * every every-th used element, including the first size - 1 positions
+ * where the window is still filling.
+ *
+ * @param[in] array Array of integers, unused elements are skipped
+ * @param[in] capacity Total number of elements in the array
+ * @param[in] size Window length in used elements
+ * @param[in] every Write a result for every every-th used element
+ * @param[out] results Buffer for the results
+ * @param[in] max_results Capacity of results; later results are dropped
+ * @return int Number of results written, -1 on bad arguments or out of memory
+ *
+ * @see Rolling_Window_Push()
+ */
+int Rolling_Stats(const int array[], int capacity, int size, int every, Rolling_Result results[], int max_results) {
+    Rolling_Window window;
+    int written = 0;
+
+    if (Rolling_Window_Init(&window, size, every) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < capacity && written < max_results; i++) {
+        if (IS_USED(array[i]) && Rolling_Window_Push(&window, array[i], &results[written])) {
+            written++;
+        }
+    }
+    Rolling_Window_Free(&window);
+    return written;
+}
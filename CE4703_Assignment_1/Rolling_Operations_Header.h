@@ -0,0 +1,62 @@
+#ifndef ROLLING_OPERATIONS_HEADER_H
+#define ROLLING_OPERATIONS_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+
+/**
+ * @brief Statistics of one window position
+ */
+typedef struct Rolling_Result {
+    long long position; // zero-based index of the newest value in the window
+    int count; // values in the window, below the window size only while it fills
+    int min; // smallest value in the window
+    int max; // largest value in the window
+    double mean; // arithmetic mean of the window
+    double variance; // population variance of the window
+    double standard_deviation; // square root of the variance
+} Rolling_Result;
+
+/**
+ * @brief Entry of a monotonic min or max deque
+ */
+typedef struct Rolling_Entry {
+    long long position; // index of the value in the stream, to expire it
+    int value; // the value itself
+} Rolling_Entry;
+
+/**
+ * @brief Sliding-window statistics over the last size values of a stream
+ *
+ * Mean and variance come from a running sum and sum of squares that gain
+ * the new value and lose the one leaving the window. Min and max come from
+ * monotonic deques: the min deque holds values in increasing order, and a
+ * value that can never be the minimum again (an older, larger one) is
+ * dropped as soon as a smaller value arrives; the max deque mirrors it.
+ * Every value enters and leaves each deque once, so a push is O(1)
+ * amortized whatever the window size. All rings are allocated once by
+ * Rolling_Window_Init().
+ */
+typedef struct Rolling_Window {
+    int size; // window length
+    int every; // a result is due for every every-th value pushed
+    int* values; // ring of the last size values
+    Rolling_Entry* min_deque; // ring of window minimum candidates, increasing from the front
+    Rolling_Entry* max_deque; // ring of window maximum candidates, decreasing from the front
+    int min_front; // slot of the front of min_deque
+    int min_length; // entries in min_deque
+    int max_front; // slot of the front of max_deque
+    int max_length; // entries in max_deque
+    long long pushed; // values pushed so far
+    long long sum; // exact sum of the window
+    int shift; // reference value for sum_squares
+    double sum_squares; // sum of (value - shift)^2 over the window
+} Rolling_Window;
+
+int Rolling_Window_Init(Rolling_Window* window, int size, int every); // allocates the rings for a window of size values emitting every every-th result, returns 0 or -1 on bad arguments or out of memory
+void Rolling_Window_Reset(Rolling_Window* window); // empties the window, keeping its rings
+void Rolling_Window_Free(Rolling_Window* window); // releases the rings
+int Rolling_Window_Push(Rolling_Window* window, int value, Rolling_Result* result); // adds a value in O(1) amortized, returns 1 and fills result if a result is due, else 0
+void Rolling_Window_Current(const Rolling_Window* window, Rolling_Result* result); // statistics of the window as it is now
+int Rolling_Stats(const int array[], int capacity, int size, int every, Rolling_Result results[], int max_results); // rolling statistics of the used elements of an array, returns the number of results written or -1
+
+#endif // ROLLING_OPERATIONS_HEADER_H
@@ -0,0 +1,510 @@
+/**
+ * @file Simd_Operation_Functions.c
+ * @brief Vectorized scan kernels with run-time CPU dispatch
+ *
+ * This file contains the kernel that accumulates count, sum, min, max and
+ * squared deviations over the used elements of an array. A scalar version
+ * is always available; SSE4.1 (4 lanes) and AVX2 (8 lanes) versions mask
+ * out unused lanes with compare and blend instead of branching. The best
+ * version supported by the CPU is chosen with CPUID on the first call.
+ *
+ * Moments_Scan_Lanes() is the batched form of the same kernel: instead of
+ * vectorizing along one array it keeps one array per lane, so thousands
+ * of short arrays are scanned at full vector width.
+ */
+
+#include "Simd_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include <limits.h>
+#include <stddef.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/* MSVC compiles intrinsics for any ISA; GCC and Clang need a per-function target */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMD_TARGET(isa)
+#else
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+typedef void (*Moments_Scan_Function)(const int array[], int count, Array_Moments* moments);
+typedef void (*Lanes_Scan_Function)(const int rows[], int row_count, int row_stride, Lane_Moments* lanes);
+
+ /**
+  * @brief Accumulates the moments of the used elements with a plain loop
+  *
+  * Reference implementation for the vectorized kernels. moments->shift
+  * must be set by the caller; every other field is overwritten.
+  *
+  * @param[in] array Array of integers to scan
+  * @param[in] count Number of elements to scan
+  * @param[in,out] moments Sums of the used elements
+  *
+  * @return void
+  *
+  * @see IS_USED
+  */
+void Moments_Scan_Scalar(const int array[], int count, Array_Moments* moments) {
+    int used = 0; /**< Counter for number of used elements */
+    long long sum = 0; /**< Exact accumulator for sum of used elements */
+    int min = INT_MAX; /**< Smallest used element seen so far */
+    int max = INT_MIN; /**< Largest used element seen so far */
+    double sum_squares = 0.0; /**< Sum of squared deviations from the shift */
+    int shift = moments->shift;
+
+    for (int i = 0; i < count; i++) {
+        int value = array[i];
+        if (IS_USED(value)) {
+            double deviation = (double)(value - shift); /**< Both non-negative so this cannot overflow */
+            used++;
+            sum += value;
+            if (value < min) {
+                min = value;
+            }
+            if (value > max) {
+                max = value;
+            }
+            sum_squares += deviation * deviation;
+        }
+    }
+
+    moments->count = used;
+    moments->sum = sum;
+    moments->min = min;
+    moments->max = max;
+    moments->sum_squares = sum_squares;
+}
+
+/**
+ * @brief Adds interleaved rows to the per-lane moments with plain loops
+ *
+ * The lane loop has a fixed trip count and no branches, so compilers can
+ * still vectorize it where the AVX2 kernel is not available.
+ *
+ * @param[in] rows First row; row r holds element r of each lane's array
+ * @param[in] row_count Number of rows to scan
+ * @param[in] row_stride Distance in ints between consecutive rows
+ * @param[in,out] lanes Running sums, one array per lane
+ */
+static void Moments_Scan_Lanes_Scalar(const int rows[], int row_count, int row_stride, Lane_Moments* lanes) {
+    for (int r = 0; r < row_count; r++) {
+        const int* row = rows + (ptrdiff_t)r * row_stride;
+        for (int lane = 0; lane < SIMD_BATCH_LANES; lane++) {
+            int value = row[lane];
+            int used = IS_USED(value);
+            double deviation = used ? (double)(value - lanes->shift[lane]) : 0.0;
+            lanes->count[lane] += used;
+            lanes->sum[lane] += used ? value : 0;
+            lanes->min[lane] = (used && value < lanes->min[lane]) ? value : lanes->min[lane];
+            lanes->max[lane] = (used && value > lanes->max[lane]) ? value : lanes->max[lane];
+            lanes->sum_squares[lane] += deviation * deviation;
+        }
+    }
+}
+
+#ifdef SIMD_X86
+
+/**
+ * @brief SSE4.1 kernel processing 4 elements per iteration
+ *
+ * A lane is used when it compares greater than -1, matching IS_USED.
+ * Unused lanes are zeroed before summing and replaced with INT_MAX
+ * before the min reduction and INT_MIN before the max reduction, so
+ * an all-unused span gives the same INT_MAX / INT_MIN as the scalar kernel.
+ *
+ * @param[in] array Array of integers to scan
+ * @param[in] count Number of elements to scan
+ * @param[in,out] moments Sums of the used elements
+ */
+SIMD_TARGET("sse4.1")
+static void Moments_Scan_Sse41(const int array[], int count, Array_Moments* moments) {
+    const __m128i minus_one = _mm_set1_epi32(-1);
+    const __m128i int_max = _mm_set1_epi32(INT_MAX);
+    const __m128i int_min = _mm_set1_epi32(INT_MIN);
+    const __m128i shift = _mm_set1_epi32(moments->shift);
+    __m128i used = _mm_setzero_si128(); /**< Per-lane used counts */
+    __m128i sum = _mm_setzero_si128(); /**< Two 64-bit partial sums */
+    __m128i min = int_max;
+    __m128i max = int_min;
+    __m128d squares = _mm_setzero_pd(); /**< Two double partial sums of squares */
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i values = _mm_loadu_si128((const __m128i*)(array + i));
+        __m128i mask = _mm_cmpgt_epi32(values, minus_one); /**< All ones in used lanes */
+        __m128i masked = _mm_and_si128(values, mask);
+        __m128i deviation = _mm_and_si128(_mm_sub_epi32(values, shift), mask);
+        __m128d low, high;
+
+        used = _mm_sub_epi32(used, mask);
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(masked));
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(_mm_srli_si128(masked, 8)));
+        min = _mm_min_epi32(min, _mm_blendv_epi8(int_max, values, mask));
+        max = _mm_max_epi32(max, _mm_blendv_epi8(int_min, values, mask));
+        low = _mm_cvtepi32_pd(deviation);
+        high = _mm_cvtepi32_pd(_mm_srli_si128(deviation, 8));
+        squares = _mm_add_pd(squares, _mm_add_pd(_mm_mul_pd(low, low), _mm_mul_pd(high, high)));
+    }
+
+    /* Horizontal reductions */
+    int lanes[4];
+    long long sums[2];
+    double square_sums[2];
+    Array_Moments tail;
+
+    _mm_storeu_si128((__m128i*)lanes, used);
+    moments->count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm_storeu_si128((__m128i*)sums, sum);
+    moments->sum = sums[0] + sums[1];
+    _mm_storeu_pd(square_sums, squares);
+    moments->sum_squares = square_sums[0] + square_sums[1];
+    min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+    min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+    moments->min = _mm_cvtsi128_si32(min);
+    max = _mm_max_epi32(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(1, 0, 3, 2)));
+    max = _mm_max_epi32(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(2, 3, 0, 1)));
+    moments->max = _mm_cvtsi128_si32(max);
+
+    /* Remaining 0-3 elements */
+    tail.shift = moments->shift;
+    Moments_Scan_Scalar(array + i, count - i, &tail);
+    moments->count += tail.count;
+    moments->sum += tail.sum;
+    moments->sum_squares += tail.sum_squares;
+    if (tail.min < moments->min) {
+        moments->min = tail.min;
+    }
+    if (tail.max > moments->max) {
+        moments->max = tail.max;
+    }
+}
+
+/**
+ * @brief AVX2 kernel processing 8 elements per iteration
+ *
+ * Same masking scheme as Moments_Scan_Sse41() on 256-bit registers.
+ *
+ * @param[in] array Array of integers to scan
+ * @param[in] count Number of elements to scan
+ * @param[in,out] moments Sums of the used elements
+ */
+SIMD_TARGET("avx2")
+static void Moments_Scan_Avx2(const int array[], int count, Array_Moments* moments) {
+    const __m256i minus_one = _mm256_set1_epi32(-1);
+    const __m256i int_max = _mm256_set1_epi32(INT_MAX);
+    const __m256i int_min = _mm256_set1_epi32(INT_MIN);
+    const __m256i shift = _mm256_set1_epi32(moments->shift);
+    __m256i used = _mm256_setzero_si256(); /**< Per-lane used counts */
+    __m256i sum = _mm256_setzero_si256(); /**< Four 64-bit partial sums */
+    __m256i min = int_max;
+    __m256i max = int_min;
+    __m256d squares = _mm256_setzero_pd(); /**< Four double partial sums of squares */
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i values = _mm256_loadu_si256((const __m256i*)(array + i));
+        __m256i mask = _mm256_cmpgt_epi32(values, minus_one); /**< All ones in used lanes */
+        __m256i masked = _mm256_and_si256(values, mask);
+        __m256i deviation = _mm256_and_si256(_mm256_sub_epi32(values, shift), mask);
+        __m256d low, high;
+
+        used = _mm256_sub_epi32(used, mask);
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(masked)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(masked, 1)));
+        min = _mm256_min_epi32(min, _mm256_blendv_epi8(int_max, values, mask));
+        max = _mm256_max_epi32(max, _mm256_blendv_epi8(int_min, values, mask));
+        low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(deviation));
+        high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(deviation, 1));
+        squares = _mm256_add_pd(squares, _mm256_add_pd(_mm256_mul_pd(low, low), _mm256_mul_pd(high, high)));
+    }
+
+    /* Horizontal reductions */
+    int lanes[8];
+    long long sums[4];
+    double square_sums[4];
+    Array_Moments tail;
+
+    _mm256_storeu_si256((__m256i*)lanes, used);
+    moments->count = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        moments->count += lanes[lane];
+    }
+    _mm256_storeu_si256((__m256i*)sums, sum);
+    moments->sum = sums[0] + sums[1] + sums[2] + sums[3];
+    _mm256_storeu_pd(square_sums, squares);
+    moments->sum_squares = square_sums[0] + square_sums[1] + square_sums[2] + square_sums[3];
+    _mm256_storeu_si256((__m256i*)lanes, min);
+    moments->min = INT_MAX;
+    for (int lane = 0; lane < 8; lane++) {
+        if (lanes[lane] < moments->min) {
+            moments->min = lanes[lane];
+        }
+    }
+    _mm256_storeu_si256((__m256i*)lanes, max);
+    moments->max = INT_MIN;
+    for (int lane = 0; lane < 8; lane++) {
+        if (lanes[lane] > moments->max) {
+            moments->max = lanes[lane];
+        }
+    }
+    _mm256_zeroupper(); /**< Clean upper halves so the scalar tail and the caller's SSE code pay no transition */
+
+    /* Remaining 0-7 elements */
+    tail.shift = moments->shift;
+    Moments_Scan_Scalar(array + i, count - i, &tail);
+    moments->count += tail.count;
+    moments->sum += tail.sum;
+    moments->sum_squares += tail.sum_squares;
+    if (tail.min < moments->min) {
+        moments->min = tail.min;
+    }
+    if (tail.max > moments->max) {
+        moments->max = tail.max;
+    }
+}
+
+/**
+ * @brief AVX2 kernel adding one row of 8 lanes per iteration
+ *
+ * Same masking scheme as Moments_Scan_Avx2(), but the lanes are never
+ * reduced: each lane is a separate array, so the accumulators are loaded
+ * from and stored back to the Lane_Moments columns as they are.
+ *
+ * @param[in] rows First row; row r holds element r of each lane's array
+ * @param[in] row_count Number of rows to scan
+ * @param[in] row_stride Distance in ints between consecutive rows
+ * @param[in,out] lanes Running sums, one array per lane
+ */
+SIMD_TARGET("avx2")
+static void Moments_Scan_Lanes_Avx2(const int rows[], int row_count, int row_stride, Lane_Moments* lanes) {
+    const __m256i minus_one = _mm256_set1_epi32(-1);
+    const __m256i int_max = _mm256_set1_epi32(INT_MAX);
+    const __m256i int_min = _mm256_set1_epi32(INT_MIN);
+    const __m256i shift = _mm256_loadu_si256((const __m256i*)lanes->shift);
+    __m256i used = _mm256_loadu_si256((const __m256i*)lanes->count);
+    __m256i sum_low = _mm256_loadu_si256((const __m256i*)lanes->sum); /**< 64-bit sums of lanes 0-3 */
+    __m256i sum_high = _mm256_loadu_si256((const __m256i*)(lanes->sum + 4)); /**< 64-bit sums of lanes 4-7 */
+    __m256i min = _mm256_loadu_si256((const __m256i*)lanes->min);
+    __m256i max = _mm256_loadu_si256((const __m256i*)lanes->max);
+    __m256d squares_low = _mm256_loadu_pd(lanes->sum_squares);
+    __m256d squares_high = _mm256_loadu_pd(lanes->sum_squares + 4);
+
+    for (int r = 0; r < row_count; r++) {
+        __m256i values = _mm256_loadu_si256((const __m256i*)(rows + (ptrdiff_t)r * row_stride));
+        __m256i mask = _mm256_cmpgt_epi32(values, minus_one); /**< All ones in used lanes */
+        __m256i masked = _mm256_and_si256(values, mask);
+        __m256i deviation = _mm256_and_si256(_mm256_sub_epi32(values, shift), mask);
+        __m256d low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(deviation));
+        __m256d high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(deviation, 1));
+
+        used = _mm256_sub_epi32(used, mask);
+        sum_low = _mm256_add_epi64(sum_low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(masked)));
+        sum_high = _mm256_add_epi64(sum_high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(masked, 1)));
+        min = _mm256_min_epi32(min, _mm256_blendv_epi8(int_max, values, mask));
+        max = _mm256_max_epi32(max, _mm256_blendv_epi8(int_min, values, mask));
+        squares_low = _mm256_add_pd(squares_low, _mm256_mul_pd(low, low));
+        squares_high = _mm256_add_pd(squares_high, _mm256_mul_pd(high, high));
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes->count, used);
+    _mm256_storeu_si256((__m256i*)lanes->sum, sum_low);
+    _mm256_storeu_si256((__m256i*)(lanes->sum + 4), sum_high);
+    _mm256_storeu_si256((__m256i*)lanes->min, min);
+    _mm256_storeu_si256((__m256i*)lanes->max, max);
+    _mm256_storeu_pd(lanes->sum_squares, squares_low);
+    _mm256_storeu_pd(lanes->sum_squares + 4, squares_high);
+    _mm256_zeroupper(); /**< Leave no dirty upper halves for the caller's SSE code */
+}
+
+/**
+ * @brief Queries CPUID for the highest supported instruction set level
+ *
+ * AVX2 additionally requires the operating system to save YMM registers,
+ * which is checked with XGETBV.
+ *
+ * @return int One of the SIMD_LEVEL_ constants
+ */
+static int Detect_Simd_Level(void) {
+    unsigned int eax, ebx, ecx, edx;
+    int level = SIMD_LEVEL_SCALAR;
+
+#if defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 0);
+    if (registers[0] < 1) {
+        return level;
+    }
+    __cpuid(registers, 1);
+    ecx = (unsigned int)registers[2];
+#else
+    if (__get_cpuid_max(0, 0) < 1) {
+        return level;
+    }
+    __cpuid(1, eax, ebx, ecx, edx);
+#endif
+
+    if (ecx & (1u << 19)) { /**< SSE4.1 */
+        level = SIMD_LEVEL_SSE41;
+    }
+
+    if ((ecx & (1u << 27)) && (ecx & (1u << 28))) { /**< OSXSAVE and AVX */
+#if defined(_MSC_VER)
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(registers, 7, 0);
+        ebx = (unsigned int)registers[1];
+#else
+        unsigned int xcr0_low, xcr0_high;
+        __asm__ volatile ("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+        unsigned long long xcr0 = ((unsigned long long)xcr0_high << 32) | xcr0_low;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#endif
+        if ((xcr0 & 0x6) == 0x6 && (ebx & (1u << 5))) { /**< XMM and YMM state enabled, AVX2 */
+            level = SIMD_LEVEL_AVX2;
+        }
+    }
+    (void)eax;
+    (void)edx;
+    return level;
+}
+
+#else
+
+static int Detect_Simd_Level(void) {
+    return SIMD_LEVEL_SCALAR;
+}
+
+#endif // SIMD_X86
+
+static int detected_level = -1; /**< Highest level supported by the CPU, -1 until detected */
+static int active_level = SIMD_LEVEL_SCALAR; /**< Level currently used by Moments_Scan() */
+static void Moments_Scan_Resolve(const int array[], int count, Array_Moments* moments);
+static Moments_Scan_Function moments_scan_implementation = Moments_Scan_Resolve; /**< Dispatch target */
+static void Moments_Scan_Lanes_Resolve(const int rows[], int row_count, int row_stride, Lane_Moments* lanes);
+static Lanes_Scan_Function lanes_scan_implementation = Moments_Scan_Lanes_Resolve; /**< Dispatch target of the batched kernel */
+
+/**
+ * @brief Points the dispatcher at the kernel for the requested level
+ *
+ * @param[in] level One of the SIMD_LEVEL_ constants, clamped to the detected level
+ */
+static void Select_Kernel(int level) {
+    if (detected_level < 0) {
+        detected_level = Detect_Simd_Level();
+    }
+    if (level > detected_level) {
+        level = detected_level;
+    }
+
+    Moments_Scan_Function scan = Moments_Scan_Scalar;
+    Lanes_Scan_Function lanes = Moments_Scan_Lanes_Scalar; /**< 4-lane SSE4.1 gains too little over the vectorized scalar loop */
+#ifdef SIMD_X86
+    if (level == SIMD_LEVEL_AVX2) {
+        scan = Moments_Scan_Avx2;
+        lanes = Moments_Scan_Lanes_Avx2;
+    }
+    else if (level == SIMD_LEVEL_SSE41) {
+        scan = Moments_Scan_Sse41;
+    }
+#endif
+    /* Each pointer is written once with its final kernel, never a placeholder */
+    active_level = level;
+    moments_scan_implementation = scan;
+    lanes_scan_implementation = lanes;
+}
+
+/**
+ * @brief First-call dispatch target: detects the CPU and forwards the call
+ */
+static void Moments_Scan_Resolve(const int array[], int count, Array_Moments* moments) {
+    Select_Kernel(SIMD_LEVEL_AVX2);
+    moments_scan_implementation(array, count, moments);
+}
+
+/**
+ * @brief First-call dispatch target of the batched kernel
+ */
+static void Moments_Scan_Lanes_Resolve(const int rows[], int row_count, int row_stride, Lane_Moments* lanes) {
+    Select_Kernel(SIMD_LEVEL_AVX2);
+    lanes_scan_implementation(rows, row_count, row_stride, lanes);
+}
+
+/**
+ * @brief Accumulates count, sum, min, max and squared deviations of used elements
+ *
+ * Calls the fastest kernel supported by the CPU, or the scalar kernel for
+ * fewer than SIMD_MIN_COUNT elements. moments->shift must be set by the
+ * caller; every other field is overwritten.
+ *
+ * @param[in] array Array of integers to scan
+ * @param[in] count Number of elements to scan
+ * @param[in,out] moments Sums of the used elements
+ *
+ * @return void
+ *
+ * @note All kernels give identical count, sum, min and max; sum_squares may
+ *       differ in the last bits because of the summation order
+ */
+void Moments_Scan(const int array[], int count, Array_Moments* moments) {
+    if (count < SIMD_MIN_COUNT) {
+        Moments_Scan_Scalar(array, count, moments);
+        return;
+    }
+    moments_scan_implementation(array, count, moments);
+}
+
+/**
+ * @brief Adds rows of interleaved values to the moments of SIMD_BATCH_LANES arrays
+ *
+ * Row r holds element r of every lane's array, so each lane accumulates
+ * one array and no horizontal reduction is needed. Unlike Moments_Scan()
+ * the sums are added to, not overwritten, so an array can be scanned in
+ * several blocks. lanes->shift must be set before the first block.
+ *
+ * @param[in] rows First row of SIMD_BATCH_LANES values
+ * @param[in] row_count Number of rows to scan
+ * @param[in] row_stride Distance in ints between consecutive rows
+ * @param[in,out] lanes Running sums, one array per lane
+ *
+ * @return void
+ */
+void Moments_Scan_Lanes(const int rows[], int row_count, int row_stride, Lane_Moments* lanes) {
+    lanes_scan_implementation(rows, row_count, row_stride, lanes);
+}
+
+/**
+ * @brief Returns the instruction set level used by Moments_Scan()
+ *
+ * The first call also resolves the kernels, so callers that fan out to
+ * the worker pool call it beforehand and the workers never race on the
+ * first-call dispatch.
+ *
+ * @return int One of the SIMD_LEVEL_ constants
+ */
+int Simd_Level(void) {
+    if (detected_level < 0) {
+        Select_Kernel(SIMD_LEVEL_AVX2);
+    }
+    return active_level;
+}
+
+/**
+ * @brief Forces Moments_Scan() to use a given instruction set level
+ *
+ * Useful for comparing the vectorized kernels against the scalar
+ * reference. Levels above what the CPU supports are clamped.
+ *
+ * @param[in] level One of the SIMD_LEVEL_ constants
+ *
+ * @return void
+ */
+void Simd_Set_Level(int level) {
+    Select_Kernel(level);
+}
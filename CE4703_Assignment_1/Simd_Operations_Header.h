@@ -0,0 +1,35 @@
+#ifndef SIMD_OPERATIONS_HEADER_H
+#define SIMD_OPERATIONS_HEADER_H // include guard
+
+#include "Maths_Operations_Header.h" // include maths header for Array_Moments
+
+// Instruction set levels, in increasing order of capability
+#define SIMD_LEVEL_SCALAR 0 // plain C loop, always available
+#define SIMD_LEVEL_SSE41 1 // 4 lanes, SSE4.1
+#define SIMD_LEVEL_AVX2 2 // 8 lanes, AVX2
+
+#define SIMD_MIN_COUNT 16 // shorter scans use the scalar kernel, the vector setup and reductions cost more than they save
+#define SIMD_BATCH_LANES 8 // arrays scanned side by side by Moments_Scan_Lanes(), one per AVX2 lane
+
+/**
+ * @brief Moments of SIMD_BATCH_LANES arrays accumulated side by side
+ *
+ * Lane l holds the running sums of array l, laid out as columns so the
+ * kernel can load and store all lanes of a field at once.
+ */
+typedef struct Lane_Moments {
+    int count[SIMD_BATCH_LANES]; // number of used elements
+    long long sum[SIMD_BATCH_LANES]; // exact sum of used elements
+    int min[SIMD_BATCH_LANES]; // smallest used element, INT_MAX if none
+    int max[SIMD_BATCH_LANES]; // largest used element, INT_MIN if none
+    int shift[SIMD_BATCH_LANES]; // reference value for the squared deviations (input to the scan)
+    double sum_squares[SIMD_BATCH_LANES]; // sum of (value - shift)^2 over used elements
+} Lane_Moments;
+
+void Moments_Scan(const int array[], int count, Array_Moments* moments); // accumulates moments of used elements with the best kernel for this CPU
+void Moments_Scan_Scalar(const int array[], int count, Array_Moments* moments); // reference scalar kernel, also the fallback
+void Moments_Scan_Lanes(const int rows[], int row_count, int row_stride, Lane_Moments* lanes); // adds row_count rows of SIMD_BATCH_LANES interleaved values, one array per lane, to the running sums
+int Simd_Level(void); // returns the instruction set level Moments_Scan() is using
+void Simd_Set_Level(int level); // forces a lower level (e.g. SIMD_LEVEL_SCALAR for comparison), clamped to what the CPU supports
+
+#endif // SIMD_OPERATIONS_HEADER_H
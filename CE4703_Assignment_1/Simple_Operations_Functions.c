@@ -10,6 +10,11 @@
 
 #include "Simple_Operations_Header.h" // linking the header definitions to 
 #include "Main_Header.h" // linking the main header definitions
+#include "Maths_Operations_Header.h" // linking the single-pass statistics
+#include "Random_Engine_Header.h" // linking the random number engine
+#include "Parse_Operations_Header.h" // linking the bulk integer parser
+#include "Output_Operations_Header.h" // linking the buffered output engine
+#include "Profile_Header.h" // linking the optional profiling probes
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
@@ -17,19 +22,22 @@
  /**
   * @brief Generates a random integer within specified range
   *
-  * Uses standard rand() function to generate a pseudo-random number
-  * between min and max (inclusive). The range is calculated using
-  * modulo arithmetic to ensure uniform distribution within bounds.
+  * Draws from the shared xoshiro256** generator (see Rng_Default()) and
+  * maps the result into [min, max] with Lemire's unbiased method, so every
+  * value in the range is equally likely.
   *
   * @param[in] min Minimum value of range (inclusive)
   * @param[in] max Maximum value of range (inclusive)
   * @return int Random integer in the range [min, max]
   *
-  * @note Requires srand() to be called elsewhere for proper randomization
+  * @note Call Random_Seed() to change the sequence; without it every run is the same
   * @warning Max must be greater than or equal to min
   */
 int Random_int(int min, int max) {
-    int random_num = min + rand() % (max - min + 1); /**< Generate random number in range */
+    PROFILE_ENTER();
+    int random_num = Rng_Range(Rng_Default(), min, max); /**< Generate random number in range */
+    PROFILE_COUNT(COUNTER_RNG_DRAWS, 1);
+    PROFILE_EXIT(PROBE_RANDOM_INT, 1);
     return random_num;
 }
 
@@ -37,29 +45,43 @@ int Random_int(int min, int max) {
  * @brief Reads non-negative integers from user input into array
  *
  * Continuously reads integer values from standard input until either
- * capacity is reached or a negative number is entered. Negative input
- * triggers early termination and remaining elements are marked unused.
+ * capacity is reached or a negative number is entered. Negative input or
+ * end of input triggers early termination and all remaining elements are
+ * marked unused. A token that is not an integer is reported with its byte
+ * offset and skipped.
  *
  * @param[out] array Array to store input values
  * @param[in] capacity Maximum number of elements to read
  *
  * @return void
  *
- * @note Uses scanf_s for secure input reading
- * @warning Input buffer should be cleared before calling this function
+ * @note Reads through the shared stdin parser, which pulls input in large
+ *       blocks instead of calling scanf_s once per value
+ * @see Parser_Next()
  */
 void Keyboard_Input(int array[], int capacity) {
-    int i;
+    PROFILE_ENTER();
+    Int_Parser* parser = Parser_Stdin();
+    int i = 0;
     int input;
+    int status;
     printf("Enter up to %d non-negative integers (negative to stop):\n", capacity);
-    for (i = 0; i < capacity; i++) {
-        scanf_s("%d", &input);
-        if (input < 0) {
-            array[i] = UNUSED_MARKER; /**< Mark current position as unused */
-            break;
+    while (i < capacity) {
+        status = Parser_Next(parser, &input);
+        if (status == PARSE_MALFORMED) {
+            printf("Skipping malformed input at byte %lld\n", parser->error_offset);
+            continue;
         }
-        array[i] = input; /**< Store valid input in array */
+        if (status == PARSE_END || input < 0) {
+            break; /**< Negative value or end of input terminates reading */
+        }
+        array[i++] = input; /**< Store valid input in array */
+    }
+    /** Mark remaining elements as unused */
+    for (; i < capacity; i++) {
+        array[i] = UNUSED_MARKER;
     }
+    PROFILE_EXIT(PROBE_KEYBOARD_INPUT, capacity);
 }
 
 /**
@@ -76,20 +98,18 @@ void Keyboard_Input(int array[], int capacity) {
  *
  * @return void
  *
- * @see Random_int()
+ * @see Rng_Fill_Range()
  */
 void Array_Random(int array[], int size, int capacity, int min, int max) {
-    int random_number = Random_int(min, max);
-    /** Fill first 'size' elements with random numbers */
-    for (int i = 0; i < size; i++) {
-        array[i] = Random_int(min, max); /**< Assign random value to current index */
-    }
+    PROFILE_ENTER();
+    /** Fill first 'size' elements with random numbers in one bulk pass */
+    Rng_Fill_Range(Rng_Default(), array, size, min, max);
     /** Mark remaining elements as unused */
     for (int j = size; j < capacity; j++) {
-        if (j >= size) {
-            array[j] = UNUSED_MARKER; /**< Set unused marker for remaining positions */
-        }
+        array[j] = UNUSED_MARKER; /**< Set unused marker for remaining positions */
     }
+    PROFILE_COUNT(COUNTER_RNG_DRAWS, size > 0 ? size : 0);
+    PROFILE_EXIT(PROBE_ARRAY_RANDOM, capacity);
 }
 
 /**
@@ -103,14 +123,14 @@ void Array_Random(int array[], int size, int capacity, int min, int max) {
  *
  * @return void
  *
- * @note Uses IS_USED macro to determine element status
+ * @note Uses IS_USED macro to determine element status. Output goes through
+ *       the buffered writer in the layout set by Output_Set_Layout()
  */
 void Print_Used(int array[], int capacity) {
-    for (int i = 0; i < capacity; i++) {
-        if (IS_USED(array[i])) {
-            printf("\nArray[%d] | %d", i, array[i]); /**< Display used element */
-        }
-    }
+    PROFILE_ENTER();
+    Output_Array(Output_Stdout(), array, capacity, Output_Layout(), 1);
+    Output_Flush(Output_Stdout());
+    PROFILE_EXIT(PROBE_PRINT_USED, capacity);
 }
 
 /**
@@ -127,79 +147,75 @@ void Print_Used(int array[], int capacity) {
  * @note Ensures unused elements are properly marked before printing
  */
 void Print_All(int array[], int capacity) {
+    PROFILE_ENTER();
     for (int i = 0; i < capacity; i++) {
         if (array[i] < 1) {
             array[i] = UNUSED_MARKER; /**< Ensure proper unused marking */
         }
-        printf("\nArray[%d] | %d", i, array[i]); /**< Display all elements */
     }
+    Output_Array(Output_Stdout(), array, capacity, Output_Layout(), 0);
+    Output_Flush(Output_Stdout());
+    PROFILE_EXIT(PROBE_PRINT_ALL, capacity);
 }
 
 /**
  * @brief Finds the minimum value among used elements in the array
  *
- * Scans through the array to locate the smallest value considering
- * only elements marked as used. Excludes unused and negative markers.
+ * Reads the smallest used value from the single-pass statistics
+ * computed by Array_Stats(). Unused elements are excluded.
  *
  * @param[in] array Array to search
  * @param[in] capacity Total number of elements in array
  * @return int Minimum value found among used elements
  *
- * @note Returns first element if no valid minimum is found
+ * @note Returns UNUSED_MARKER if the array has no used elements
+ * @see Array_Stats()
  */
 int Find_Min(int array[], int capacity) {
-    int min = array[0]; /**< Initialize with first element */
-    for (int i = 1; i < capacity; i++) {
-        if ((array[i] < min) && array[i] > -1) {
-            min = array[i]; /**< Update minimum when smaller valid value found */
-        }
-    }
-    return min;
+    PROFILE_ENTER();
+    Array_Statistics stats; /**< Statistics of the used elements */
+    Array_Stats(array, capacity, &stats);
+    PROFILE_EXIT(PROBE_FIND_MIN, capacity);
+    return stats.min;
 }
 
 /**
  * @brief Finds the maximum value among used elements in the array
  *
- * Scans through the array to locate the largest value considering
- * all elements regardless of usage status.
+ * Reads the largest used value from the single-pass statistics
+ * computed by Array_Stats(). Unused elements are excluded.
  *
  * @param[in] array Array to search
  * @param[in] capacity Total number of elements in array
- * @return int Maximum value found in the array
+ * @return int Maximum value found among used elements
  *
- * @note Returns first element if no larger value is found
+ * @note Returns UNUSED_MARKER if the array has no used elements
+ * @see Array_Stats()
  */
 int Find_Max(int array[], int capacity) {
-    int max = array[0]; /**< Initialize with first element */
-    for (int i = 1; i < capacity; i++) {
-        if (array[i] > max) {
-            max = array[i]; /**< Update maximum when larger value found */
-        }
-    }
-    return max;
+    PROFILE_ENTER();
+    Array_Statistics stats; /**< Statistics of the used elements */
+    Array_Stats(array, capacity, &stats);
+    PROFILE_EXIT(PROBE_FIND_MAX, capacity);
+    return stats.max;
 }
 
 /**
  * @brief Counts the number of used elements in the array
  *
- * Iterates through the entire array and counts how many elements
- * are marked as used using the IS_USED macro.
+ * Reads the count of elements marked as used (see IS_USED) from
+ * the single-pass statistics computed by Array_Stats().
  *
  * @param[in] array Array to analyze
  * @param[in] capacity Total number of elements in array
  * @return int Number of used elements in the array
  *
- * @see IS_USED
+ * @see IS_USED, Array_Stats()
  */
 int Num_of_Used_Elements(int array[], int capacity) {
-    int count = 0; /**< Counter for used elements */
-    for (int x = 0; x < capacity; x++) {
-        if (IS_USED(array[x])) {
-            count++; /**< Increment counter for each used element */
-        }
-    }
-    return count;
+    PROFILE_ENTER();
+    Array_Statistics stats; /**< Statistics of the used elements */
+    Array_Stats(array, capacity, &stats);
+    PROFILE_EXIT(PROBE_NUM_OF_USED_ELEMENTS, capacity);
+    return stats.count;
 }
-
-
-
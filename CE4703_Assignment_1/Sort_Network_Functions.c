@@ -0,0 +1,537 @@
+/**
+ * @file Sort_Network_Functions.c
+ * @brief Unrolled sorting networks for inputs of up to 32 elements
+ *
+ * A sorting network is a fixed sequence of compare-exchanges, so it runs
+ * the same instructions whatever the data and has no branches to
+ * mispredict: each CX() compiles to a pair of conditional moves. That
+ * beats insertion sort and introsort for the tiny arrays of the menus
+ * (capacities 10 and 20) and for the small partitions that introsort and
+ * introselect finish with.
+ *
+ * Up to 16 inputs every network has the fewest comparators known for its
+ * size. The 10-input network is Waksman's; the 16-input network opens with
+ * Green's four hypercube layers and matches his 60 comparators, and the
+ * 15- and 14-input networks are cut down from it. Each larger size sorts
+ * its two halves with the smaller networks and joins them with Batcher's
+ * odd-even merge, a few comparators above the best known networks for 17
+ * to 20 (93 against 91 for 20) and level with them for 32. Comparators
+ * on one line are independent and can execute in parallel. Every network
+ * was checked with the 0-1 principle.
+ */
+
+#include "Sort_Network_Header.h" // linking the header definitions
+
+/* Branchless compare-exchange: smaller value to d[a], larger to d[b] */
+#define CX(a, b) { int x = d[a], y = d[b]; d[a] = (x < y) ? x : y; d[b] = (x < y) ? y : x; }
+
+static void Network_2(int d[]) { /* 1 comparator, depth 1 */
+    CX(0, 1)
+}
+
+static void Network_3(int d[]) { /* 3 comparators, depth 3 */
+    CX(0, 1)
+    CX(0, 2)
+    CX(1, 2)
+}
+
+static void Network_4(int d[]) { /* 5 comparators, depth 3 */
+    CX(0, 1) CX(2, 3)
+    CX(0, 2) CX(1, 3)
+    CX(1, 2)
+}
+
+static void Network_5(int d[]) { /* 9 comparators, depth 5 */
+    CX(0, 1) CX(2, 3)
+    CX(0, 2) CX(1, 3)
+    CX(1, 2) CX(0, 4)
+    CX(2, 4)
+    CX(1, 2) CX(3, 4)
+}
+
+static void Network_6(int d[]) { /* 12 comparators, depth 6 */
+    CX(0, 1) CX(2, 3) CX(4, 5)
+    CX(0, 2) CX(1, 3)
+    CX(1, 2) CX(0, 4)
+    CX(2, 4) CX(1, 5)
+    CX(3, 5) CX(1, 2)
+    CX(3, 4)
+}
+
+static void Network_7(int d[]) { /* 16 comparators, depth 6 */
+    CX(0, 1) CX(2, 3) CX(4, 5)
+    CX(0, 2) CX(1, 3) CX(4, 6)
+    CX(1, 2) CX(5, 6) CX(0, 4)
+    CX(2, 6) CX(1, 5)
+    CX(2, 4) CX(3, 5)
+    CX(1, 2) CX(3, 4) CX(5, 6)
+}
+
+static void Network_8(int d[]) { /* 19 comparators, depth 6 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7)
+    CX(1, 2) CX(5, 6) CX(0, 4) CX(3, 7)
+    CX(2, 6) CX(1, 5)
+    CX(2, 4) CX(3, 5)
+    CX(1, 2) CX(3, 4) CX(5, 6)
+}
+
+static void Network_9(int d[]) { /* 25 comparators, depth 8 */
+    CX(2, 6) CX(0, 4) CX(3, 7) CX(5, 8)
+    CX(1, 8) CX(5, 6) CX(2, 3)
+    CX(0, 1) CX(6, 7) CX(4, 8)
+    CX(3, 4) CX(1, 6) CX(0, 5) CX(7, 8)
+    CX(1, 3) CX(4, 6) CX(2, 5)
+    CX(4, 5) CX(6, 7) CX(0, 2)
+    CX(3, 4) CX(5, 6) CX(1, 2)
+    CX(4, 5) CX(2, 3)
+}
+
+static void Network_10(int d[]) { /* 29 comparators, depth 8 */
+    CX(0, 8) CX(1, 9) CX(2, 7) CX(3, 5) CX(4, 6)
+    CX(0, 2) CX(1, 4) CX(5, 8) CX(7, 9)
+    CX(0, 3) CX(2, 4) CX(5, 7) CX(6, 9)
+    CX(0, 1) CX(3, 6) CX(8, 9)
+    CX(1, 5) CX(2, 3) CX(4, 8) CX(6, 7)
+    CX(1, 2) CX(3, 5) CX(4, 6) CX(7, 8)
+    CX(2, 3) CX(4, 5) CX(6, 7)
+    CX(3, 4) CX(5, 6)
+}
+
+static void Network_11(int d[]) { /* 35 comparators, depth 9 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10)
+    CX(1, 2) CX(9, 10) CX(5, 6) CX(0, 4)
+    CX(6, 9) CX(1, 8) CX(3, 10)
+    CX(2, 6) CX(3, 7) CX(5, 8)
+    CX(6, 9) CX(1, 5) CX(3, 4) CX(7, 10)
+    CX(2, 3) CX(4, 8) CX(7, 9) CX(0, 1)
+    CX(3, 5) CX(1, 2) CX(7, 8) CX(4, 6)
+    CX(6, 7) CX(2, 3) CX(4, 5)
+}
+
+static void Network_12(int d[]) { /* 39 comparators, depth 10 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(5, 6)
+    CX(9, 10) CX(4, 8) CX(1, 2) CX(7, 11)
+    CX(5, 9) CX(2, 8) CX(6, 10) CX(1, 4)
+    CX(3, 9) CX(7, 10) CX(2, 4)
+    CX(3, 8) CX(7, 9)
+    CX(6, 8) CX(3, 5)
+    CX(7, 8) CX(5, 6) CX(3, 4)
+}
+
+static void Network_13(int d[]) { /* 45 comparators, depth 10 */
+    CX(0, 12) CX(1, 10) CX(2, 9) CX(3, 7) CX(5, 11) CX(6, 8)
+    CX(1, 6) CX(2, 3) CX(4, 11) CX(7, 9) CX(8, 10)
+    CX(0, 4) CX(1, 2) CX(3, 6) CX(7, 8) CX(9, 10) CX(11, 12)
+    CX(4, 6) CX(5, 9) CX(8, 11) CX(10, 12)
+    CX(0, 5) CX(3, 8) CX(4, 7) CX(6, 11) CX(9, 10)
+    CX(0, 1) CX(2, 5) CX(6, 9) CX(7, 8) CX(10, 11)
+    CX(1, 3) CX(2, 4) CX(5, 6) CX(9, 10)
+    CX(1, 2) CX(3, 4) CX(5, 7) CX(6, 8)
+    CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9)
+    CX(3, 4) CX(5, 6)
+}
+
+static void Network_14(int d[]) { /* 51 comparators, depth 10 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13)
+    CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13) CX(5, 10)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(1, 2)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4)
+    CX(6, 7) CX(8, 9)
+}
+
+static void Network_15(int d[]) { /* 56 comparators, depth 10 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13) CX(10, 14)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13) CX(6, 14)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13) CX(5, 10)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4)
+    CX(6, 7) CX(8, 9)
+}
+
+static void Network_16(int d[]) { /* 60 comparators, depth 10 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13) CX(14, 15)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14) CX(13, 15)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13) CX(10, 14) CX(11, 15)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13) CX(6, 14) CX(7, 15)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13) CX(5, 10)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4)
+    CX(6, 7) CX(8, 9)
+}
+
+static void Network_17(int d[]) { /* 73 comparators, depth 12 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(10, 14) CX(8, 12) CX(11, 15) CX(13, 16)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(9, 16) CX(13, 14) CX(10, 11)
+    CX(1, 2) CX(5, 6) CX(0, 4) CX(3, 7) CX(8, 9) CX(14, 15) CX(12, 16)
+    CX(2, 6) CX(1, 5) CX(11, 12) CX(9, 14) CX(8, 13) CX(15, 16)
+    CX(2, 4) CX(3, 5) CX(9, 11) CX(12, 14) CX(10, 13)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(12, 13) CX(14, 15) CX(8, 10)
+    CX(11, 12) CX(13, 14) CX(9, 10) CX(0, 8) CX(7, 15)
+    CX(12, 13) CX(10, 11) CX(8, 16) CX(6, 14) CX(1, 9)
+    CX(4, 12) CX(2, 10) CX(5, 13) CX(3, 11)
+    CX(4, 8) CX(12, 16) CX(6, 10) CX(5, 9) CX(7, 11)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(3, 5) CX(7, 9) CX(11, 13)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16)
+}
+
+static void Network_18(int d[]) { /* 80 comparators, depth 12 */
+    CX(2, 6) CX(0, 4) CX(3, 7) CX(5, 8) CX(11, 15) CX(9, 13) CX(12, 16) CX(14, 17)
+    CX(1, 8) CX(5, 6) CX(2, 3) CX(10, 17) CX(14, 15) CX(11, 12)
+    CX(0, 1) CX(6, 7) CX(4, 8) CX(9, 10) CX(15, 16) CX(13, 17)
+    CX(3, 4) CX(1, 6) CX(0, 5) CX(7, 8) CX(12, 13) CX(10, 15) CX(9, 14) CX(16, 17)
+    CX(1, 3) CX(4, 6) CX(2, 5) CX(10, 12) CX(13, 15) CX(11, 14) CX(8, 17)
+    CX(4, 5) CX(6, 7) CX(0, 2) CX(13, 14) CX(15, 16) CX(9, 11)
+    CX(3, 4) CX(5, 6) CX(1, 2) CX(12, 13) CX(14, 15) CX(10, 11) CX(0, 9) CX(7, 16)
+    CX(4, 5) CX(2, 3) CX(13, 14) CX(11, 12) CX(8, 9) CX(6, 15) CX(1, 10)
+    CX(4, 13) CX(2, 11) CX(5, 14) CX(3, 12)
+    CX(4, 8) CX(9, 13) CX(6, 11) CX(5, 10) CX(7, 12)
+    CX(2, 4) CX(6, 8) CX(9, 11) CX(13, 15) CX(3, 5) CX(7, 10) CX(12, 14)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16)
+}
+
+static void Network_19(int d[]) { /* 88 comparators, depth 12 */
+    CX(2, 6) CX(0, 4) CX(3, 7) CX(5, 8) CX(9, 17) CX(10, 18) CX(11, 16) CX(12, 14) CX(13, 15)
+    CX(1, 8) CX(5, 6) CX(2, 3) CX(9, 11) CX(10, 13) CX(14, 17) CX(16, 18)
+    CX(0, 1) CX(6, 7) CX(4, 8) CX(9, 12) CX(11, 13) CX(14, 16) CX(15, 18)
+    CX(3, 4) CX(1, 6) CX(0, 5) CX(7, 8) CX(9, 10) CX(12, 15) CX(17, 18)
+    CX(1, 3) CX(4, 6) CX(2, 5) CX(10, 14) CX(11, 12) CX(13, 17) CX(15, 16)
+    CX(4, 5) CX(6, 7) CX(0, 2) CX(10, 11) CX(12, 14) CX(13, 15) CX(16, 17)
+    CX(3, 4) CX(5, 6) CX(1, 2) CX(11, 12) CX(13, 14) CX(15, 16) CX(0, 9) CX(8, 17)
+    CX(4, 5) CX(2, 3) CX(12, 13) CX(14, 15) CX(8, 9) CX(1, 10) CX(7, 16)
+    CX(4, 13) CX(2, 11) CX(6, 15) CX(10, 18) CX(5, 14) CX(3, 12)
+    CX(4, 8) CX(9, 13) CX(6, 11) CX(5, 10) CX(14, 18) CX(7, 12)
+    CX(2, 4) CX(6, 8) CX(9, 11) CX(13, 15) CX(3, 5) CX(7, 10) CX(12, 14) CX(16, 18)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18)
+}
+
+static void Network_20(int d[]) { /* 93 comparators, depth 12 */
+    CX(0, 8) CX(1, 9) CX(2, 7) CX(3, 5) CX(4, 6) CX(10, 18) CX(11, 19) CX(12, 17) CX(13, 15) CX(14, 16)
+    CX(0, 2) CX(1, 4) CX(5, 8) CX(7, 9) CX(10, 12) CX(11, 14) CX(15, 18) CX(17, 19)
+    CX(0, 3) CX(2, 4) CX(5, 7) CX(6, 9) CX(10, 13) CX(12, 14) CX(15, 17) CX(16, 19)
+    CX(0, 1) CX(3, 6) CX(8, 9) CX(10, 11) CX(13, 16) CX(18, 19)
+    CX(1, 5) CX(2, 3) CX(4, 8) CX(6, 7) CX(11, 15) CX(12, 13) CX(14, 18) CX(16, 17) CX(0, 10) CX(9, 19)
+    CX(1, 2) CX(3, 5) CX(4, 6) CX(7, 8) CX(11, 12) CX(13, 15) CX(14, 16) CX(17, 18)
+    CX(2, 3) CX(4, 5) CX(6, 7) CX(12, 13) CX(14, 15) CX(16, 17) CX(8, 18) CX(1, 11)
+    CX(3, 4) CX(5, 6) CX(13, 14) CX(15, 16) CX(8, 10) CX(2, 12) CX(9, 11) CX(7, 17)
+    CX(4, 14) CX(6, 16) CX(5, 15) CX(3, 13)
+    CX(4, 8) CX(10, 14) CX(6, 12) CX(5, 9) CX(11, 15) CX(7, 13)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(3, 5) CX(7, 9) CX(11, 13) CX(15, 17)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18)
+}
+
+static void Network_21(int d[]) { /* 103 comparators, depth 14 */
+    CX(0, 8) CX(1, 9) CX(2, 7) CX(3, 5) CX(4, 6) CX(10, 11) CX(12, 13) CX(14, 15) CX(16, 17) CX(18, 19)
+    CX(0, 2) CX(1, 4) CX(5, 8) CX(7, 9) CX(10, 12) CX(11, 13) CX(14, 16) CX(15, 17) CX(18, 20)
+    CX(0, 3) CX(2, 4) CX(5, 7) CX(6, 9) CX(11, 12) CX(19, 20) CX(15, 16) CX(10, 14)
+    CX(0, 1) CX(3, 6) CX(8, 9) CX(16, 19) CX(11, 18) CX(13, 20)
+    CX(1, 5) CX(2, 3) CX(4, 8) CX(6, 7) CX(12, 16) CX(13, 17) CX(15, 18)
+    CX(1, 2) CX(3, 5) CX(4, 6) CX(7, 8) CX(16, 19) CX(11, 15) CX(13, 14) CX(17, 20)
+    CX(2, 3) CX(4, 5) CX(6, 7) CX(12, 13) CX(14, 18) CX(17, 19) CX(10, 11)
+    CX(3, 4) CX(5, 6) CX(13, 15) CX(11, 12) CX(17, 18) CX(14, 16) CX(0, 10) CX(9, 19)
+    CX(16, 17) CX(12, 13) CX(14, 15) CX(8, 18) CX(1, 11)
+    CX(8, 10) CX(4, 14) CX(2, 12) CX(6, 16) CX(9, 11) CX(5, 15) CX(3, 13) CX(7, 17)
+    CX(4, 8) CX(10, 14) CX(12, 20) CX(5, 9) CX(11, 15) CX(7, 13)
+    CX(6, 12) CX(16, 20) CX(2, 4) CX(3, 5) CX(7, 9) CX(11, 13) CX(15, 17)
+    CX(6, 8) CX(10, 12) CX(14, 16) CX(18, 20) CX(1, 2) CX(3, 4)
+    CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20)
+}
+
+static void Network_22(int d[]) { /* 110 comparators, depth 14 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(11, 13) CX(12, 14) CX(15, 17) CX(16, 18) CX(19, 21)
+    CX(1, 2) CX(9, 10) CX(5, 6) CX(0, 4) CX(12, 13) CX(20, 21) CX(16, 17) CX(11, 15)
+    CX(6, 9) CX(1, 8) CX(3, 10) CX(17, 20) CX(12, 19) CX(14, 21)
+    CX(2, 6) CX(3, 7) CX(5, 8) CX(13, 17) CX(14, 18) CX(16, 19)
+    CX(6, 9) CX(1, 5) CX(3, 4) CX(7, 10) CX(17, 20) CX(12, 16) CX(14, 15) CX(18, 21)
+    CX(2, 3) CX(4, 8) CX(7, 9) CX(0, 1) CX(13, 14) CX(15, 19) CX(18, 20) CX(11, 12) CX(10, 21)
+    CX(3, 5) CX(1, 2) CX(7, 8) CX(4, 6) CX(14, 16) CX(12, 13) CX(18, 19) CX(15, 17) CX(0, 11) CX(9, 20)
+    CX(6, 7) CX(2, 3) CX(4, 5) CX(17, 18) CX(13, 14) CX(15, 16) CX(8, 19) CX(1, 12)
+    CX(8, 11) CX(4, 15) CX(2, 13) CX(6, 17) CX(9, 12) CX(5, 16) CX(3, 14) CX(7, 18)
+    CX(4, 8) CX(11, 15) CX(10, 13) CX(5, 9) CX(12, 16) CX(7, 14)
+    CX(6, 10) CX(13, 17) CX(2, 4) CX(3, 5) CX(7, 9) CX(12, 14) CX(16, 18)
+    CX(6, 8) CX(10, 11) CX(13, 15) CX(17, 19) CX(1, 2) CX(3, 4)
+    CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20)
+}
+
+static void Network_23(int d[]) { /* 118 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(11, 13) CX(12, 14) CX(15, 17) CX(16, 18) CX(19, 21) CX(20, 22)
+    CX(1, 2) CX(9, 10) CX(5, 6) CX(0, 4) CX(11, 15) CX(12, 16) CX(13, 17) CX(14, 18)
+    CX(6, 9) CX(1, 8) CX(3, 10) CX(11, 19) CX(12, 20) CX(13, 21) CX(14, 22) CX(16, 17)
+    CX(2, 6) CX(3, 7) CX(5, 8) CX(20, 21) CX(15, 19) CX(12, 13) CX(18, 22)
+    CX(6, 9) CX(1, 5) CX(3, 4) CX(7, 10) CX(16, 20) CX(13, 19) CX(17, 21) CX(12, 15)
+    CX(2, 3) CX(4, 8) CX(7, 9) CX(0, 1) CX(14, 20) CX(18, 21) CX(13, 15)
+    CX(3, 5) CX(1, 2) CX(7, 8) CX(4, 6) CX(14, 19) CX(18, 20) CX(0, 11) CX(10, 21)
+    CX(6, 7) CX(2, 3) CX(4, 5) CX(17, 19) CX(14, 16) CX(1, 12) CX(9, 20)
+    CX(18, 19) CX(16, 17) CX(14, 15) CX(2, 13) CX(9, 12)
+    CX(8, 19) CX(4, 15) CX(10, 13) CX(6, 17) CX(5, 16) CX(3, 14) CX(7, 18)
+    CX(8, 11) CX(6, 10) CX(13, 17) CX(5, 9) CX(12, 16) CX(14, 22)
+    CX(4, 8) CX(11, 15) CX(17, 19) CX(7, 14) CX(18, 22) CX(3, 5)
+    CX(2, 4) CX(6, 8) CX(10, 11) CX(13, 15) CX(7, 9) CX(12, 14) CX(16, 18) CX(20, 22)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22)
+}
+
+static void Network_24(int d[]) { /* 123 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11)
+    CX(12, 13) CX(14, 15) CX(16, 17) CX(18, 19) CX(20, 21) CX(22, 23)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11)
+    CX(12, 14) CX(13, 15) CX(16, 18) CX(17, 19) CX(20, 22) CX(21, 23)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(12, 16) CX(13, 17) CX(14, 18) CX(15, 19)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(5, 6) CX(12, 20) CX(13, 21) CX(14, 22) CX(15, 23) CX(17, 18)
+    CX(9, 10) CX(4, 8) CX(1, 2) CX(7, 11) CX(21, 22) CX(16, 20) CX(13, 14) CX(19, 23) CX(0, 12)
+    CX(5, 9) CX(2, 8) CX(6, 10) CX(1, 4) CX(17, 21) CX(14, 20) CX(18, 22) CX(13, 16) CX(11, 23)
+    CX(3, 9) CX(7, 10) CX(2, 4) CX(15, 21) CX(19, 22) CX(14, 16) CX(1, 13)
+    CX(3, 8) CX(7, 9) CX(15, 20) CX(19, 21) CX(2, 14) CX(10, 22)
+    CX(6, 8) CX(3, 5) CX(18, 20) CX(15, 17) CX(10, 14) CX(9, 21)
+    CX(7, 8) CX(5, 6) CX(3, 4) CX(19, 20) CX(17, 18) CX(15, 16) CX(9, 13)
+    CX(8, 20) CX(4, 16) CX(6, 18) CX(5, 17) CX(3, 15) CX(7, 19)
+    CX(8, 12) CX(6, 10) CX(14, 18) CX(5, 9) CX(13, 17) CX(11, 15)
+    CX(4, 8) CX(12, 16) CX(18, 20) CX(7, 11) CX(15, 19) CX(3, 5)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(7, 9) CX(11, 13) CX(15, 17) CX(19, 21)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22)
+}
+
+static void Network_25(int d[]) { /* 133 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11)
+    CX(12, 24) CX(13, 22) CX(14, 21) CX(15, 19) CX(17, 23) CX(18, 20)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(13, 18) CX(14, 15) CX(16, 23) CX(19, 21) CX(20, 22)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(12, 16) CX(13, 14) CX(15, 18) CX(19, 20) CX(21, 22) CX(23, 24)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(5, 6) CX(16, 18) CX(17, 21) CX(20, 23) CX(22, 24)
+    CX(9, 10) CX(4, 8) CX(1, 2) CX(7, 11) CX(12, 17) CX(15, 20) CX(16, 19) CX(18, 23) CX(21, 22)
+    CX(5, 9) CX(2, 8) CX(6, 10) CX(1, 4) CX(12, 13) CX(14, 17) CX(18, 21) CX(19, 20) CX(22, 23)
+    CX(3, 9) CX(7, 10) CX(2, 4) CX(13, 15) CX(14, 16) CX(17, 18) CX(21, 22) CX(0, 12) CX(11, 23)
+    CX(3, 8) CX(7, 9) CX(13, 14) CX(15, 16) CX(17, 19) CX(18, 20) CX(10, 22)
+    CX(6, 8) CX(3, 5) CX(14, 15) CX(16, 17) CX(18, 19) CX(20, 21) CX(1, 13)
+    CX(7, 8) CX(5, 6) CX(3, 4) CX(15, 16) CX(17, 18) CX(2, 14) CX(9, 21)
+    CX(8, 20) CX(4, 16) CX(10, 14) CX(6, 18) CX(9, 13) CX(5, 17) CX(3, 15) CX(7, 19)
+    CX(8, 12) CX(16, 24) CX(6, 10) CX(14, 18) CX(5, 9) CX(13, 17) CX(11, 15)
+    CX(4, 8) CX(12, 16) CX(20, 24) CX(7, 11) CX(15, 19) CX(3, 5)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(18, 20) CX(22, 24) CX(7, 9) CX(11, 13) CX(15, 17) CX(19, 21)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12)
+    CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24)
+}
+
+static void Network_26(int d[]) { /* 140 comparators, depth 15 */
+    CX(0, 12) CX(1, 10) CX(2, 9) CX(3, 7) CX(5, 11) CX(6, 8)
+    CX(13, 25) CX(14, 23) CX(15, 22) CX(16, 20) CX(18, 24) CX(19, 21)
+    CX(1, 6) CX(2, 3) CX(4, 11) CX(7, 9) CX(8, 10) CX(14, 19) CX(15, 16) CX(17, 24) CX(20, 22) CX(21, 23)
+    CX(0, 4) CX(1, 2) CX(3, 6) CX(7, 8) CX(9, 10) CX(11, 12)
+    CX(13, 17) CX(14, 15) CX(16, 19) CX(20, 21) CX(22, 23) CX(24, 25)
+    CX(4, 6) CX(5, 9) CX(8, 11) CX(10, 12) CX(17, 19) CX(18, 22) CX(21, 24) CX(23, 25)
+    CX(0, 5) CX(3, 8) CX(4, 7) CX(6, 11) CX(9, 10) CX(13, 18) CX(16, 21) CX(17, 20) CX(19, 24) CX(22, 23) CX(12, 25)
+    CX(0, 1) CX(2, 5) CX(6, 9) CX(7, 8) CX(10, 11) CX(13, 14) CX(15, 18) CX(19, 22) CX(20, 21) CX(23, 24)
+    CX(1, 3) CX(2, 4) CX(5, 6) CX(9, 10) CX(14, 16) CX(15, 17) CX(18, 19) CX(22, 23) CX(0, 13) CX(11, 24)
+    CX(1, 2) CX(3, 4) CX(5, 7) CX(6, 8) CX(14, 15) CX(16, 17) CX(18, 20) CX(19, 21) CX(10, 23)
+    CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(1, 14)
+    CX(3, 4) CX(5, 6) CX(16, 17) CX(18, 19) CX(8, 21) CX(2, 15) CX(9, 22) CX(7, 20)
+    CX(8, 13) CX(4, 17) CX(10, 15) CX(6, 19) CX(9, 14) CX(5, 18) CX(3, 16)
+    CX(12, 17) CX(4, 8) CX(6, 10) CX(15, 19) CX(5, 9) CX(14, 18) CX(11, 16)
+    CX(12, 13) CX(17, 21) CX(2, 4) CX(6, 8) CX(7, 11) CX(16, 20) CX(3, 5)
+    CX(10, 12) CX(13, 15) CX(17, 19) CX(21, 23) CX(7, 9) CX(11, 14) CX(16, 18) CX(20, 22) CX(1, 2) CX(3, 4) CX(5, 6)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24)
+}
+
+static void Network_27(int d[]) { /* 150 comparators, depth 15 */
+    CX(0, 12) CX(1, 10) CX(2, 9) CX(3, 7) CX(5, 11) CX(6, 8) CX(13, 14)
+    CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26)
+    CX(1, 6) CX(2, 3) CX(4, 11) CX(7, 9) CX(8, 10) CX(13, 15) CX(14, 16) CX(17, 19) CX(18, 20) CX(21, 23) CX(22, 24)
+    CX(0, 4) CX(1, 2) CX(3, 6) CX(7, 8) CX(9, 10) CX(11, 12)
+    CX(13, 17) CX(14, 18) CX(15, 19) CX(16, 20) CX(21, 25) CX(22, 26)
+    CX(4, 6) CX(5, 9) CX(8, 11) CX(10, 12) CX(13, 21) CX(14, 22) CX(15, 23) CX(16, 24) CX(17, 25) CX(18, 26)
+    CX(0, 5) CX(3, 8) CX(4, 7) CX(6, 11) CX(9, 10) CX(14, 17) CX(19, 22) CX(16, 25) CX(15, 21) CX(20, 26) CX(18, 23)
+    CX(0, 1) CX(2, 5) CX(6, 9) CX(7, 8) CX(10, 11) CX(22, 25) CX(16, 19) CX(17, 21) CX(20, 24) CX(14, 15)
+    CX(1, 3) CX(2, 4) CX(5, 6) CX(9, 10) CX(18, 21) CX(20, 23) CX(15, 17) CX(24, 26) CX(0, 13)
+    CX(1, 2) CX(3, 4) CX(5, 7) CX(6, 8) CX(20, 22) CX(19, 21) CX(16, 18) CX(23, 25)
+    CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(20, 21) CX(22, 23) CX(24, 25) CX(18, 19) CX(16, 17) CX(1, 14)
+    CX(3, 4) CX(5, 6) CX(19, 20) CX(21, 22) CX(12, 25) CX(2, 15) CX(10, 23) CX(11, 24)
+    CX(8, 21) CX(4, 17) CX(10, 15) CX(6, 19) CX(9, 22) CX(5, 18) CX(3, 16) CX(7, 20)
+    CX(8, 13) CX(12, 17) CX(6, 10) CX(15, 19) CX(9, 14) CX(18, 26) CX(11, 16)
+    CX(4, 8) CX(12, 13) CX(17, 21) CX(5, 9) CX(14, 18) CX(22, 26) CX(7, 11) CX(16, 20)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(13, 15) CX(17, 19) CX(21, 23)
+    CX(3, 5) CX(7, 9) CX(11, 14) CX(16, 18) CX(20, 22) CX(24, 26)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14)
+    CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26)
+}
+
+static void Network_28(int d[]) { /* 156 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13)
+    CX(14, 15) CX(16, 17) CX(18, 19) CX(20, 21) CX(22, 23) CX(24, 25) CX(26, 27)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14)
+    CX(13, 15) CX(16, 18) CX(17, 19) CX(20, 22) CX(21, 23) CX(24, 26) CX(25, 27)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13)
+    CX(10, 14) CX(11, 15) CX(16, 20) CX(17, 21) CX(18, 22) CX(19, 23)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13) CX(6, 14)
+    CX(7, 15) CX(16, 24) CX(17, 25) CX(18, 26) CX(19, 27) CX(21, 22)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13)
+    CX(5, 10) CX(25, 26) CX(20, 24) CX(17, 18) CX(23, 27) CX(0, 16)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2) CX(21, 25) CX(18, 24) CX(22, 26) CX(17, 20)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13) CX(19, 25) CX(23, 26) CX(18, 20) CX(1, 17)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12) CX(19, 24) CX(23, 25) CX(2, 18)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4) CX(22, 24) CX(19, 21)
+    CX(6, 7) CX(8, 9) CX(23, 24) CX(21, 22) CX(19, 20) CX(10, 26) CX(11, 27)
+    CX(8, 24) CX(4, 20) CX(10, 18) CX(6, 22) CX(9, 25) CX(5, 21) CX(3, 19) CX(7, 23)
+    CX(8, 16) CX(12, 20) CX(14, 22) CX(6, 10) CX(9, 17) CX(13, 21) CX(11, 19) CX(15, 23)
+    CX(4, 8) CX(12, 16) CX(20, 24) CX(14, 18) CX(22, 26) CX(5, 9) CX(13, 17) CX(21, 25) CX(7, 11) CX(15, 19) CX(23, 27)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(18, 20) CX(22, 24)
+    CX(3, 5) CX(7, 9) CX(11, 13) CX(15, 17) CX(19, 21) CX(23, 25)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14)
+    CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26)
+}
+
+static void Network_29(int d[]) { /* 165 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13)
+    CX(14, 15) CX(16, 28) CX(17, 26) CX(18, 25) CX(19, 23) CX(21, 27) CX(22, 24)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14)
+    CX(13, 15) CX(17, 22) CX(18, 19) CX(20, 27) CX(23, 25) CX(24, 26)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13) CX(10, 14)
+    CX(11, 15) CX(16, 20) CX(17, 18) CX(19, 22) CX(23, 24) CX(25, 26) CX(27, 28)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13)
+    CX(6, 14) CX(7, 15) CX(20, 22) CX(21, 25) CX(24, 27) CX(26, 28)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13)
+    CX(5, 10) CX(16, 21) CX(19, 24) CX(20, 23) CX(22, 27) CX(25, 26)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2) CX(16, 17) CX(18, 21) CX(22, 25) CX(23, 24) CX(26, 27)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13) CX(17, 19) CX(18, 20) CX(21, 22) CX(25, 26) CX(0, 16)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12) CX(17, 18) CX(19, 20) CX(21, 23) CX(22, 24)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4) CX(18, 19) CX(20, 21) CX(22, 23) CX(24, 25) CX(1, 17)
+    CX(6, 7) CX(8, 9) CX(19, 20) CX(21, 22) CX(12, 28) CX(2, 18) CX(10, 26) CX(11, 27)
+    CX(8, 24) CX(4, 20) CX(10, 18) CX(6, 22) CX(9, 25) CX(5, 21) CX(3, 19) CX(7, 23)
+    CX(8, 16) CX(12, 20) CX(14, 22) CX(6, 10) CX(9, 17) CX(13, 21) CX(11, 19) CX(15, 23)
+    CX(4, 8) CX(12, 16) CX(20, 24) CX(14, 18) CX(22, 26) CX(5, 9) CX(13, 17) CX(21, 25) CX(7, 11) CX(15, 19) CX(23, 27)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(18, 20) CX(22, 24) CX(26, 28)
+    CX(3, 5) CX(7, 9) CX(11, 13) CX(15, 17) CX(19, 21) CX(23, 25)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14)
+    CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26) CX(27, 28)
+}
+
+static void Network_30(int d[]) { /* 172 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13)
+    CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26) CX(27, 28)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14)
+    CX(15, 17) CX(16, 18) CX(19, 21) CX(20, 22) CX(23, 25) CX(24, 26) CX(27, 29)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13) CX(10, 14)
+    CX(15, 19) CX(16, 20) CX(17, 21) CX(18, 22) CX(23, 27) CX(24, 28) CX(25, 29)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13) CX(6, 14)
+    CX(15, 23) CX(16, 24) CX(17, 25) CX(18, 26) CX(19, 27) CX(20, 28) CX(21, 29)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13) CX(5, 10) CX(26, 29)
+    CX(16, 19) CX(21, 24) CX(18, 27) CX(17, 23) CX(22, 28) CX(20, 25) CX(0, 15)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2)
+    CX(24, 27) CX(18, 21) CX(19, 23) CX(22, 26) CX(28, 29) CX(16, 17)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13) CX(20, 23) CX(22, 25) CX(17, 19) CX(26, 28) CX(14, 29) CX(1, 16)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12) CX(22, 24) CX(21, 23) CX(18, 20) CX(25, 27) CX(2, 17) CX(13, 28)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4) CX(22, 23) CX(24, 25) CX(26, 27) CX(20, 21) CX(18, 19)
+    CX(6, 7) CX(8, 9) CX(21, 22) CX(23, 24) CX(4, 19) CX(12, 27) CX(10, 25) CX(5, 20) CX(3, 18) CX(11, 26)
+    CX(8, 23) CX(12, 19) CX(10, 17) CX(6, 21) CX(9, 24) CX(13, 20) CX(11, 18) CX(7, 22)
+    CX(8, 15) CX(19, 23) CX(14, 21) CX(6, 10) CX(9, 16) CX(20, 24) CX(7, 11) CX(18, 22)
+    CX(4, 8) CX(12, 15) CX(14, 17) CX(21, 25) CX(5, 9) CX(13, 16) CX(20, 22) CX(24, 26)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 15) CX(17, 19) CX(21, 23) CX(25, 27) CX(3, 5) CX(7, 9) CX(11, 13) CX(16, 18)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14)
+    CX(15, 16) CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26) CX(27, 28)
+}
+
+static void Network_31(int d[]) { /* 180 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13) CX(15, 16)
+    CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26) CX(27, 28) CX(29, 30)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14) CX(15, 17)
+    CX(16, 18) CX(19, 21) CX(20, 22) CX(23, 25) CX(24, 26) CX(27, 29) CX(28, 30)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13) CX(10, 14) CX(15, 19)
+    CX(16, 20) CX(17, 21) CX(18, 22) CX(23, 27) CX(24, 28) CX(25, 29) CX(26, 30)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13) CX(6, 14) CX(15, 23)
+    CX(16, 24) CX(17, 25) CX(18, 26) CX(19, 27) CX(20, 28) CX(21, 29) CX(22, 30)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13) CX(5, 10) CX(26, 29)
+    CX(16, 19) CX(21, 24) CX(18, 27) CX(17, 23) CX(22, 28) CX(20, 25) CX(0, 15)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2)
+    CX(24, 27) CX(18, 21) CX(19, 23) CX(22, 26) CX(28, 29) CX(16, 17)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13) CX(20, 23) CX(22, 25) CX(17, 19) CX(26, 28) CX(14, 29) CX(1, 16)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12) CX(22, 24) CX(21, 23) CX(18, 20) CX(25, 27) CX(2, 17) CX(13, 28)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4) CX(22, 23) CX(24, 25) CX(26, 27) CX(20, 21) CX(18, 19)
+    CX(6, 7) CX(8, 9) CX(21, 22) CX(23, 24) CX(4, 19) CX(12, 27) CX(10, 25) CX(5, 20) CX(3, 18) CX(11, 26)
+    CX(8, 23) CX(12, 19) CX(10, 17) CX(6, 21) CX(9, 24) CX(13, 20) CX(11, 18) CX(7, 22)
+    CX(8, 15) CX(19, 23) CX(14, 21) CX(6, 10) CX(9, 16) CX(20, 24) CX(22, 30) CX(7, 11)
+    CX(4, 8) CX(12, 15) CX(14, 17) CX(21, 25) CX(5, 9) CX(13, 16) CX(18, 22) CX(26, 30)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 15) CX(17, 19) CX(21, 23) CX(25, 27)
+    CX(3, 5) CX(7, 9) CX(11, 13) CX(16, 18) CX(20, 22) CX(24, 26) CX(28, 30)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16)
+    CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26) CX(27, 28) CX(29, 30)
+}
+
+static void Network_32(int d[]) { /* 185 comparators, depth 15 */
+    CX(0, 1) CX(2, 3) CX(4, 5) CX(6, 7) CX(8, 9) CX(10, 11) CX(12, 13) CX(14, 15)
+    CX(16, 17) CX(18, 19) CX(20, 21) CX(22, 23) CX(24, 25) CX(26, 27) CX(28, 29) CX(30, 31)
+    CX(0, 2) CX(1, 3) CX(4, 6) CX(5, 7) CX(8, 10) CX(9, 11) CX(12, 14) CX(13, 15)
+    CX(16, 18) CX(17, 19) CX(20, 22) CX(21, 23) CX(24, 26) CX(25, 27) CX(28, 30) CX(29, 31)
+    CX(0, 4) CX(1, 5) CX(2, 6) CX(3, 7) CX(8, 12) CX(9, 13) CX(10, 14) CX(11, 15)
+    CX(16, 20) CX(17, 21) CX(18, 22) CX(19, 23) CX(24, 28) CX(25, 29) CX(26, 30) CX(27, 31)
+    CX(0, 8) CX(1, 9) CX(2, 10) CX(3, 11) CX(4, 12) CX(5, 13) CX(6, 14) CX(7, 15)
+    CX(16, 24) CX(17, 25) CX(18, 26) CX(19, 27) CX(20, 28) CX(21, 29) CX(22, 30) CX(23, 31)
+    CX(11, 14) CX(1, 4) CX(6, 9) CX(3, 12) CX(2, 8) CX(7, 13) CX(5, 10) CX(27, 30)
+    CX(17, 20) CX(22, 25) CX(19, 28) CX(18, 24) CX(23, 29) CX(21, 26) CX(0, 16) CX(15, 31)
+    CX(9, 12) CX(3, 6) CX(4, 8) CX(7, 11) CX(13, 14) CX(1, 2)
+    CX(25, 28) CX(19, 22) CX(20, 24) CX(23, 27) CX(29, 30) CX(17, 18)
+    CX(5, 8) CX(7, 10) CX(2, 4) CX(11, 13) CX(21, 24) CX(23, 26) CX(18, 20) CX(27, 29) CX(14, 30) CX(1, 17)
+    CX(7, 9) CX(6, 8) CX(3, 5) CX(10, 12) CX(23, 25) CX(22, 24) CX(19, 21) CX(26, 28) CX(2, 18) CX(13, 29)
+    CX(7, 8) CX(9, 10) CX(11, 12) CX(5, 6) CX(3, 4) CX(23, 24) CX(25, 26) CX(27, 28) CX(21, 22) CX(19, 20)
+    CX(6, 7) CX(8, 9) CX(22, 23) CX(24, 25) CX(4, 20) CX(12, 28) CX(10, 26) CX(5, 21) CX(3, 19) CX(11, 27)
+    CX(8, 24) CX(12, 20) CX(10, 18) CX(6, 22) CX(9, 25) CX(13, 21) CX(11, 19) CX(7, 23)
+    CX(8, 16) CX(20, 24) CX(14, 22) CX(6, 10) CX(9, 17) CX(21, 25) CX(15, 23) CX(7, 11)
+    CX(4, 8) CX(12, 16) CX(14, 18) CX(22, 26) CX(5, 9) CX(13, 17) CX(15, 19) CX(23, 27)
+    CX(2, 4) CX(6, 8) CX(10, 12) CX(14, 16) CX(18, 20) CX(22, 24) CX(26, 28)
+    CX(3, 5) CX(7, 9) CX(11, 13) CX(15, 17) CX(19, 21) CX(23, 25) CX(27, 29)
+    CX(1, 2) CX(3, 4) CX(5, 6) CX(7, 8) CX(9, 10) CX(11, 12) CX(13, 14) CX(15, 16)
+    CX(17, 18) CX(19, 20) CX(21, 22) CX(23, 24) CX(25, 26) CX(27, 28) CX(29, 30)
+}
+typedef void (*Network)(int d[]); // unrolled network for one input size
+
+static const Network networks[SORT_NETWORK_MAX + 1] = {
+    0, 0, Network_2, Network_3, Network_4, Network_5, Network_6, Network_7, Network_8,
+    Network_9, Network_10, Network_11, Network_12, Network_13, Network_14, Network_15, Network_16,
+    Network_17, Network_18, Network_19, Network_20, Network_21, Network_22, Network_23, Network_24,
+    Network_25, Network_26, Network_27, Network_28, Network_29, Network_30, Network_31, Network_32
+}; /**< Network for each input size, none needed below 2 */
+
+static const unsigned char comparators[SORT_NETWORK_MAX + 1] = {
+    0, 0, 1, 3, 5, 9, 12, 16, 19, 25, 29, 35, 39, 45, 51, 56, 60,
+    73, 80, 88, 93, 103, 110, 118, 123, 133, 140, 150, 156, 165, 172, 180, 185
+}; /**< Compare-exchanges in each network */
+
+/**
+ * @brief Sorts a small buffer in ascending order with a sorting network
+ *
+ * @param[in,out] data Buffer to sort
+ * @param[in] count Number of elements in data
+ *
+ * @return void
+ *
+ * @note Does nothing if count is above SORT_NETWORK_MAX; callers dispatch
+ *       on the size first
+ */
+void Sort_Network(int data[], int count) {
+    if (count >= 2 && count <= SORT_NETWORK_MAX) {
+        networks[count](data);
+    }
+}
+
+/**
+ * @brief Returns the number of compare-exchanges a network performs
+ *
+ * @param[in] count Number of elements to sort
+ * @return int Comparators in the network for count, 0 if none is used
+ */
+int Sort_Network_Comparators(int count) {
+    return (count >= 2 && count <= SORT_NETWORK_MAX) ? comparators[count] : 0;
+}
@@ -0,0 +1,9 @@
+#ifndef SORT_NETWORK_HEADER_H
+#define SORT_NETWORK_HEADER_H // include guard
+
+#define SORT_NETWORK_MAX 32 // largest input sorted by a fixed network
+
+void Sort_Network(int data[], int count); // sorts up to SORT_NETWORK_MAX elements with a branchless unrolled network, larger counts are left alone
+int Sort_Network_Comparators(int count); // number of compare-exchanges Sort_Network() performs for count elements
+
+#endif // SORT_NETWORK_HEADER_H
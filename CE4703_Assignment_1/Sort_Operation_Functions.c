@@ -0,0 +1,629 @@
+/**
+ * @file Sort_Operation_Functions.c
+ * @brief Implementation of the sort and selection engine
+ *
+ * This file provides the building blocks for sorting the used elements of
+ * an array: compaction of used elements into a dense prefix, an LSD radix
+ * sort for large inputs and an introsort for small inputs or when no
+ * scratch memory is available. It also provides introselect, used for
+ * medians and other order statistics without a full sort.
+ */
+
+#include "Sort_Operations_Header.h" // linking the header definitions
+#include "Main_Header.h" // linking the main header definitions
+#include "Parallel_Header.h" // linking the worker pool for large sorts
+#include "Arena_Header.h" // linking the scratch arena
+#include "Profile_Header.h" // linking the optional profiling counters
+#include "Histogram_Operations_Header.h" // linking the counting sort for small ranges
+#include "Sort_Network_Header.h" // linking the sorting networks for tiny inputs
+#include <stdlib.h>
+#include <string.h>
+
+#define RADIX_BITS 8 // bits consumed per radix pass
+#define RADIX_BUCKETS (1 << RADIX_BITS) // number of buckets per radix pass
+#define RADIX_PASSES 4 // passes needed to cover a 32-bit key
+
+ /**
+  * @brief Moves all used elements to the front of the array
+  *
+  * Performs a stable, single-pass compaction: used elements keep their
+  * relative order and are packed into indices [0, used), and every slot
+  * after them is set to UNUSED_MARKER.
+  *
+  * @param[in,out] array Array to be compacted
+  * @param[in] capacity Total number of elements in the array
+  * @return int Number of used elements now stored in the dense prefix
+  *
+  * @code
+  * int arr[5] = {5, UNUSED, 3, 1, UNUSED};
+  * int used = Compact_Used(arr, 5); // used = 3, arr = {5, 3, 1, UNUSED, UNUSED}
+  * @endcode
+  */
+int Compact_Used(int array[], int capacity) {
+    int used = 0; /**< Write position of the next used element */
+
+    for (int i = 0; i < capacity; i++) {
+        if (IS_USED(array[i])) {
+            array[used++] = array[i]; /**< Pack used element into the prefix */
+        }
+    }
+    for (int i = used; i < capacity; i++) {
+        array[i] = UNUSED_MARKER; /**< Mark the tail as unused */
+    }
+    return used;
+}
+
+/**
+ * @brief Sorts non-negative integers in ascending order with an LSD radix sort
+ *
+ * Counts all digit histograms in a single pass, then scatters the data
+ * back and forth between the array and the scratch buffer one byte at a
+ * time, least significant byte first. Passes whose byte is the same for
+ * every key are skipped, so small value ranges only cost one or two passes.
+ *
+ * @param[in,out] data Array of non-negative integers to sort
+ * @param[in] count Number of elements in data
+ * @param[out] scratch Temporary buffer of at least count elements
+ *
+ * @return void
+ *
+ * @note Runs in O(n) time; the result always ends up in data
+ * @warning All values must be non-negative (i.e. pass IS_USED)
+ */
+void Radix_Sort(int data[], int count, int scratch[]) {
+    size_t histogram[RADIX_PASSES][RADIX_BUCKETS]; /**< Digit counts for every pass */
+    int* source = data; /**< Buffer being read in the current pass */
+    int* destination = scratch; /**< Buffer being written in the current pass */
+
+    if (count < 2) {
+        return;
+    }
+
+    memset(histogram, 0, sizeof(histogram));
+    for (int i = 0; i < count; i++) {
+        unsigned int key = (unsigned int)data[i];
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            histogram[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        size_t* counts = histogram[pass];
+        size_t offset = 0;
+        int shift = pass * RADIX_BITS;
+
+        /* Every key shares this digit, so the pass would not move anything */
+        if (counts[((unsigned int)data[0] >> shift) & (RADIX_BUCKETS - 1)] == (size_t)count) {
+            continue;
+        }
+
+        /* Turn counts into starting offsets */
+        for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+            size_t bucket_count = counts[bucket];
+            counts[bucket] = offset;
+            offset += bucket_count;
+        }
+
+        for (int i = 0; i < count; i++) {
+            unsigned int key = (unsigned int)source[i];
+            destination[counts[(key >> shift) & (RADIX_BUCKETS - 1)]++] = source[i];
+        }
+
+        int* temp = source; /**< Swap the roles of the two buffers */
+        source = destination;
+        destination = temp;
+        PROFILE_COUNT(COUNTER_SORT_RADIX_PASSES, 1);
+    }
+
+    if (source != data) {
+        memcpy(data, source, (size_t)count * sizeof(int)); /**< Odd number of passes ran */
+    }
+}
+
+/**
+ * @brief Sorts a small range with a branchless sorting network
+ *
+ * @param[in,out] data Array to sort
+ * @param[in] low First index of the range (inclusive)
+ * @param[in] high Last index of the range (inclusive), at most SORT_NETWORK_MAX elements from low
+ *
+ * @see Sort_Network()
+ */
+static void Small_Sort(int data[], int low, int high) {
+    Sort_Network(data + low, high - low + 1);
+    PROFILE_COUNT(COUNTER_SORT_COMPARISONS, Sort_Network_Comparators(high - low + 1));
+}
+
+/**
+ * @brief Restores the max-heap property below a node of a heap
+ *
+ * @param[in,out] data Heap stored in array form starting at data[0]
+ * @param[in] root Index of the node to sift down
+ * @param[in] count Number of elements in the heap
+ */
+static void Sift_Down(int data[], int root, int count) {
+    int value = data[root];
+    for (;;) {
+        int child = 2 * root + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && data[child + 1] > data[child]) {
+            child++; /**< Pick the larger child */
+        }
+        PROFILE_COUNT(COUNTER_SORT_COMPARISONS, (child + 1 < count) + 1);
+        if (data[child] <= value) {
+            break;
+        }
+        data[root] = data[child];
+        PROFILE_COUNT(COUNTER_SORT_SWAPS, 1);
+        root = child;
+    }
+    data[root] = value;
+}
+
+/**
+ * @brief Sorts an array with heapsort
+ *
+ * Used by introsort when quicksort recursion gets too deep, which
+ * guarantees O(n log n) worst-case behaviour.
+ *
+ * @param[in,out] data Array to sort
+ * @param[in] count Number of elements in data
+ */
+static void Heap_Sort(int data[], int count) {
+    for (int i = count / 2 - 1; i >= 0; i--) {
+        Sift_Down(data, i, count);
+    }
+    for (int end = count - 1; end > 0; end--) {
+        int temp = data[0];
+        data[0] = data[end];
+        data[end] = temp;
+        PROFILE_COUNT(COUNTER_SORT_SWAPS, 1);
+        Sift_Down(data, 0, end);
+    }
+}
+
+/**
+ * @brief Recursive introsort step on the range [low, high]
+ *
+ * Partitions around a median-of-three pivot, recurses into the smaller
+ * side and loops on the larger one so the stack stays O(log n). Falls
+ * back to heapsort when depth_limit runs out and to a sorting network for
+ * small partitions.
+ *
+ * @param[in,out] data Array to sort
+ * @param[in] low First index of the range (inclusive)
+ * @param[in] high Last index of the range (inclusive)
+ * @param[in] depth_limit Remaining quicksort levels before heapsort is used
+ */
+static void Intro_Sort_Range(int data[], int low, int high, int depth_limit) {
+    while (high - low + 1 > INSERTION_SORT_THRESHOLD) {
+        if (depth_limit-- == 0) {
+            Heap_Sort(data + low, high - low + 1);
+            return;
+        }
+
+        /* Median-of-three pivot selection */
+        int mid = low + (high - low) / 2;
+        int a = data[low], b = data[mid], c = data[high];
+        int pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+                            : ((a < c) ? a : ((b < c) ? c : b));
+
+        /* Hoare partition */
+        int i = low - 1;
+        int j = high + 1;
+        for (;;) {
+            do { i++; } while (data[i] < pivot);
+            do { j--; } while (data[j] > pivot);
+            if (i >= j) {
+                break;
+            }
+            int temp = data[i];
+            data[i] = data[j];
+            data[j] = temp;
+            PROFILE_COUNT(COUNTER_SORT_SWAPS, 1);
+        }
+        PROFILE_COUNT(COUNTER_SORT_COMPARISONS, (i - low + 1) + (high + 1 - j)); /**< One per scan step */
+
+        if (j - low < high - j) {
+            Intro_Sort_Range(data, low, j, depth_limit);
+            low = j + 1;
+        }
+        else {
+            Intro_Sort_Range(data, j + 1, high, depth_limit);
+            high = j;
+        }
+    }
+    Small_Sort(data, low, high);
+}
+
+/**
+ * @brief Sorts an array in ascending order with introsort
+ *
+ * Quicksort with median-of-three pivots, switching to heapsort after
+ * 2*log2(n) levels and to a sorting network for small partitions.
+ *
+ * @param[in,out] data Array to sort
+ * @param[in] count Number of elements in data
+ *
+ * @return void
+ *
+ * @note O(n log n) worst case, in place, not stable
+ */
+void Intro_Sort(int data[], int count) {
+    int depth_limit = 0; /**< 2 * floor(log2(count)) */
+    for (int n = count; n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+    if (count > 1) {
+        Intro_Sort_Range(data, 0, count - 1, depth_limit);
+    }
+}
+
+/**
+ * @brief Chooses a pivot with the median-of-medians rule
+ *
+ * Sorts each group of five elements, gathers the group medians at the
+ * start of the range and selects their median. The returned pivot is
+ * guaranteed to have at least 30% of the range on each side, which bounds
+ * selection to linear time.
+ *
+ * @param[in,out] data Array holding the range
+ * @param[in] low First index of the range (inclusive)
+ * @param[in] high Last index of the range (inclusive)
+ * @return int Index of the chosen pivot
+ */
+static int Median_Of_Medians(int data[], int low, int high);
+
+/**
+ * @brief Introselect step: places the k-th smallest element of [low, high] at index k
+ *
+ * Uses median-of-three pivots with a three-way partition, so runs of
+ * equal values finish early. Once depth_limit runs out the pivots come
+ * from Median_Of_Medians(), guaranteeing O(n) worst case.
+ *
+ * @param[in,out] data Array holding the range
+ * @param[in] low First index of the range (inclusive)
+ * @param[in] high Last index of the range (inclusive)
+ * @param[in] k Target index, low <= k <= high
+ * @param[in] depth_limit Remaining median-of-three rounds before median-of-medians is used
+ */
+static void Select_Range(int data[], int low, int high, int k, int depth_limit) {
+    while (high > low) {
+        if (high - low + 1 <= INSERTION_SORT_THRESHOLD) {
+            Small_Sort(data, low, high);
+            return;
+        }
+
+        int pivot; /**< Partitioning value */
+        if (depth_limit > 0) {
+            depth_limit--;
+            int mid = low + (high - low) / 2;
+            int a = data[low], b = data[mid], c = data[high];
+            pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+                            : ((a < c) ? a : ((b < c) ? c : b));
+        }
+        else {
+            pivot = data[Median_Of_Medians(data, low, high)];
+        }
+
+        /* Three-way partition into < pivot | == pivot | > pivot */
+        int less = low;
+        int i = low;
+        int greater = high;
+        while (i <= greater) {
+            int value = data[i];
+            if (value < pivot) {
+                data[i++] = data[less];
+                data[less++] = value;
+                PROFILE_COUNT(COUNTER_SORT_SWAPS, 1);
+            }
+            else if (value > pivot) {
+                data[i] = data[greater];
+                data[greater--] = value;
+                PROFILE_COUNT(COUNTER_SORT_SWAPS, 1);
+            }
+            else {
+                i++;
+            }
+        }
+        PROFILE_COUNT(COUNTER_SORT_COMPARISONS, high - low + 1); /**< At least one per element */
+
+        if (k < less) {
+            high = less - 1;
+        }
+        else if (k > greater) {
+            low = greater + 1;
+        }
+        else {
+            return; /**< k falls inside the run equal to the pivot */
+        }
+    }
+}
+
+static int Median_Of_Medians(int data[], int low, int high) {
+    int medians_end = low; /**< One past the last gathered group median */
+
+    if (high - low + 1 <= 5) {
+        Small_Sort(data, low, high);
+        return low + (high - low) / 2;
+    }
+
+    for (int group = low; group <= high; group += 5) {
+        int group_end = (group + 4 < high) ? group + 4 : high;
+        int median = group + (group_end - group) / 2;
+        Small_Sort(data, group, group_end);
+
+        int temp = data[median]; /**< Move the group median to the front */
+        data[median] = data[medians_end];
+        data[medians_end++] = temp;
+    }
+
+    int middle = low + (medians_end - 1 - low) / 2;
+    Select_Range(data, low, medians_end - 1, middle, 0);
+    return middle;
+}
+
+/**
+ * @brief Partially orders an array so that data[k] is its k-th smallest element
+ *
+ * After the call every element before index k is <= data[k] and every
+ * element after it is >= data[k], like C++ std::nth_element.
+ *
+ * @param[in,out] data Array to rearrange
+ * @param[in] count Number of elements in data
+ * @param[in] k Zero-based rank to select, 0 <= k < count
+ * @return int The k-th smallest value
+ *
+ * @note O(n) average and worst case (introselect)
+ */
+int Select_Nth(int data[], int count, int k) {
+    int depth_limit = 0; /**< 2 * floor(log2(count)) */
+    for (int n = count; n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+    Select_Range(data, 0, count - 1, k, depth_limit);
+    return data[k];
+}
+
+/**
+ * @brief Shared state of a parallel merge sort
+ */
+typedef struct Sort_Job {
+    int* data; // buffer being sorted
+    int* scratch; // temporary buffer of the same length
+    int count; // number of elements
+    int runs; // number of independently sorted runs, a power of two
+    int run_width; // runs per merged pair in the current round (input width * 2)
+    int segments; // output segments each merged pair is split into
+    const int* source; // buffer read in the current merge round
+    int* destination; // buffer written in the current merge round
+} Sort_Job;
+
+/**
+ * @brief Returns the first index of a run
+ *
+ * @param[in] job Sort being run
+ * @param[in] run Run number, 0 to job->runs inclusive
+ * @return int Index of the first element of the run
+ */
+static int Run_Start(const Sort_Job* job, int run) {
+    return (int)((long long)job->count * run / job->runs);
+}
+
+/**
+ * @brief Sorts one run with the radix sort or introsort
+ *
+ * @param[in,out] data Run to sort
+ * @param[in] count Number of elements in the run
+ * @param[out] scratch Temporary buffer of at least count elements
+ */
+static void Sort_Run(int data[], int count, int scratch[]) {
+    if (count < RADIX_SORT_THRESHOLD) {
+        Intro_Sort(data, count);
+    }
+    else {
+        Radix_Sort(data, count, scratch);
+    }
+}
+
+/**
+ * @brief Parallel task: sorts one run in place
+ */
+static void Sort_Run_Task(void* context, int run) {
+    Sort_Job* job = context;
+    int start = Run_Start(job, run);
+
+    Sort_Run(job->data + start, Run_Start(job, run + 1) - start, job->scratch + start);
+}
+
+/**
+ * @brief Finds how many of the first k merged outputs come from the first run
+ *
+ * Binary search on the merge path of two sorted runs, which lets the
+ * output of a merge be cut into independent segments.
+ *
+ * @param[in] k Number of merged outputs, 0 <= k <= first_count + second_count
+ * @param[in] first First sorted run
+ * @param[in] first_count Length of the first run
+ * @param[in] second Second sorted run
+ * @param[in] second_count Length of the second run
+ * @return int Number of elements taken from the first run
+ */
+static int Co_Rank(int k, const int first[], int first_count, const int second[], int second_count) {
+    int low = (k > second_count) ? k - second_count : 0;
+    int high = (k < first_count) ? k : first_count;
+
+    while (low < high) {
+        int i = low + (high - low) / 2;
+        int j = k - i;
+        if (j > 0 && first[i] <= second[j - 1]) {
+            low = i + 1; /**< first[i] belongs before second[j - 1], take more from the first run */
+        }
+        else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Parallel task: writes one output segment of one pairwise merge
+ */
+static void Merge_Segment_Task(void* context, int task) {
+    Sort_Job* job = context;
+    int pair = task / job->segments;
+    int segment = task % job->segments;
+    int start = Run_Start(job, pair * job->run_width);
+    int split = Run_Start(job, pair * job->run_width + job->run_width / 2);
+    int end = Run_Start(job, (pair + 1) * job->run_width);
+    const int* first = job->source + start;
+    const int* second = job->source + split;
+    int first_count = split - start;
+    int second_count = end - split;
+    int total = end - start;
+    int k_begin = (int)((long long)total * segment / job->segments);
+    int k_end = (int)((long long)total * (segment + 1) / job->segments);
+    int i = Co_Rank(k_begin, first, first_count, second, second_count);
+    int j = k_begin - i;
+    int i_end = Co_Rank(k_end, first, first_count, second, second_count);
+    int j_end = k_end - i_end;
+    int* out = job->destination + start + k_begin;
+
+    while (i < i_end && j < j_end) {
+        *out++ = (first[i] <= second[j]) ? first[i++] : second[j++];
+    }
+    PROFILE_COUNT(COUNTER_SORT_COMPARISONS, out - (job->destination + start + k_begin));
+    while (i < i_end) {
+        *out++ = first[i++];
+    }
+    while (j < j_end) {
+        *out++ = second[j++];
+    }
+}
+
+/**
+ * @brief Parallel task: copies one run from scratch back into data
+ */
+static void Copy_Back_Task(void* context, int run) {
+    Sort_Job* job = context;
+    int start = Run_Start(job, run);
+
+    memcpy(job->data + start, job->scratch + start, (size_t)(Run_Start(job, run + 1) - start) * sizeof(int));
+}
+
+/**
+ * @brief Sorts a large buffer on all cores with a parallel merge sort
+ *
+ * The buffer is cut into a power-of-two number of runs that are sorted
+ * in parallel. The runs are then merged pairwise, round by round,
+ * alternating between data and scratch. Each pairwise merge is split
+ * into segments along its merge path, so every thread stays busy even in
+ * the last rounds, when only a few merges remain.
+ *
+ * @param[in,out] data Buffer to sort
+ * @param[in] count Number of elements
+ * @param[in,out] scratch Temporary buffer of count elements
+ * @param[in] threads Number of threads available
+ */
+static void Parallel_Merge_Sort(int data[], int count, int scratch[], int threads) {
+    Sort_Job job = { data, scratch, count, 1, 0, 0, NULL, NULL };
+
+    while (job.runs < threads && job.runs < PARALLEL_SORT_MAX_RUNS) {
+        job.runs *= 2;
+    }
+    Parallel_Run(job.runs, Sort_Run_Task, &job);
+
+    job.source = data;
+    job.destination = scratch;
+    for (job.run_width = 2; job.run_width <= job.runs; job.run_width *= 2) {
+        int pairs = job.runs / job.run_width;
+        job.segments = (threads * 2 + pairs - 1) / pairs; /**< About two segments per thread in every round */
+        Parallel_Run(pairs * job.segments, Merge_Segment_Task, &job);
+
+        const int* previous = job.source; /**< Swap the roles of the two buffers */
+        job.source = job.destination;
+        job.destination = (int*)previous;
+    }
+
+    if (job.source != data) {
+        Parallel_Run(job.runs, Copy_Back_Task, &job); /**< Odd number of merge rounds ran */
+    }
+}
+
+/**
+ * @brief Counting-sorts a dense buffer if its value range is small enough
+ *
+ * @param[in,out] data Buffer holding only used (non-negative) values
+ * @param[in] count Number of elements in data
+ * @return int Non-zero if data was sorted, zero if another sort must be used
+ *
+ * @see Histogram_Fits()
+ */
+static int Counting_Sort(int data[], int count) {
+    Histogram histogram; /**< Count table of the buffer */
+    int min, max;
+    int sorted = 0;
+
+    Histogram_Bounds(data, count, &min, &max);
+    if (!Histogram_Fits(min, max, count)) {
+        return 0;
+    }
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    if (Histogram_Build(&histogram, data, count, min, max) == 0) {
+        Histogram_Sort(&histogram, data);
+        sorted = 1;
+    }
+    Arena_Restore(Scratch_Arena(), mark);
+    return sorted;
+}
+
+/**
+ * @brief Sorts a dense buffer of used elements in ascending order
+ *
+ * Up to SORT_NETWORK_MAX elements are sorted by an unrolled sorting
+ * network. When the values span a small range compared to their number,
+ * an O(n + range) counting sort is used. Otherwise the algorithm is picked
+ * by size. Below RADIX_SORT_THRESHOLD elements an
+ * in-place introsort is used. Large inputs use an O(n) LSD radix sort.
+ * From PARALLEL_SORT_THRESHOLD elements upward, and when more than one
+ * thread is configured (see Parallel_Set_Threads()), a parallel merge
+ * sort is used instead. If the scratch buffer cannot be allocated the
+ * introsort is used.
+ *
+ * @param[in,out] data Buffer holding only used (non-negative) values
+ * @param[in] count Number of elements in data
+ *
+ * @return void
+ */
+void Sort_Dense(int data[], int count) {
+    if (count <= SORT_NETWORK_MAX) {
+        Small_Sort(data, 0, count - 1);
+        return;
+    }
+    if (count >= HISTOGRAM_MIN_COUNT && Counting_Sort(data, count)) {
+        return;
+    }
+    if (count < RADIX_SORT_THRESHOLD) {
+        Intro_Sort(data, count);
+        return;
+    }
+
+    Arena* arena = Scratch_Arena();
+    Arena_Mark mark = Arena_Save(arena);
+    int* scratch = Arena_Alloc(arena, (size_t)count * sizeof(int)); /**< Temporary buffer for radix passes and merges */
+    if (scratch == NULL) {
+        Intro_Sort(data, count); /**< Fall back to the in-place sort when memory is short */
+        return;
+    }
+
+    int threads = Parallel_Thread_Count();
+    if (count >= PARALLEL_SORT_THRESHOLD && threads > 1) {
+        Parallel_Merge_Sort(data, count, scratch, threads);
+    }
+    else {
+        Radix_Sort(data, count, scratch);
+    }
+    Arena_Restore(arena, mark);
+}
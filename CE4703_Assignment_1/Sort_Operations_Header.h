@@ -0,0 +1,17 @@
+#ifndef SORT_OPERATIONS_HEADER_H
+#define SORT_OPERATIONS_HEADER_H // include guard
+
+#include "Main_Header.h" // include main header for macros
+
+#define RADIX_SORT_THRESHOLD 256 // below this many used elements introsort is faster than radix sort
+#define INSERTION_SORT_THRESHOLD 16 // partitions this small are finished with a sorting network (insertion sort in the generic kernels)
+#define PARALLEL_SORT_THRESHOLD (1 << 18) // inputs this large are sorted on all cores, smaller ones stay sequential
+#define PARALLEL_SORT_MAX_RUNS 64 // upper bound on independently sorted runs in a parallel sort
+
+int Compact_Used(int array[], int capacity); // moves used elements to a dense prefix, marks the tail unused and returns the used count
+void Radix_Sort(int data[], int count, int scratch[]); // LSD radix sort of non-negative integers using a scratch buffer of count elements
+void Intro_Sort(int data[], int count); // in-place introsort (quicksort with heapsort fallback)
+void Sort_Dense(int data[], int count); // sorts a buffer of used elements: sorting network up to 32, counting sort for small value ranges, else introsort, radix sort or parallel merge sort by size
+int Select_Nth(int data[], int count, int k); // places the k-th smallest element at data[k] in O(n) and returns it
+
+#endif // SORT_OPERATIONS_HEADER_H
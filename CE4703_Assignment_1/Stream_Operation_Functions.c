@@ -0,0 +1,259 @@
+/**
+ * @file Stream_Operation_Functions.c
+ * @brief Streaming ingestion with online statistics
+ *
+ * This file reads an unbounded sequence of integers from a stream or a
+ * file descriptor and keeps running count, sum, min, max, mean and
+ * variance as each value arrives, so no array has to hold the values.
+ * An attached Quantile_Sketch adds approximate tail percentiles in fixed
+ * memory.
+ */
+
+#include "Stream_Operations_Header.h" // linking the header definitions
+#include "Arena_Header.h" // linking the scratch arena
+#include <stdio.h>
+#include <math.h>
+#include <limits.h>
+
+ /**
+  * @brief Resets the running statistics
+  *
+  * @param[out] stats Statistics to reset
+  *
+  * @return void
+  */
+void Stream_Stats_Init(Stream_Statistics* stats) {
+    stats->count = 0;
+    stats->sum = 0;
+    stats->min = INT_MAX;
+    stats->max = INT_MIN;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+    stats->sketch = NULL;
+}
+
+/**
+ * @brief Attaches a percentile sketch to the running statistics
+ *
+ * The sketch is emptied and from then on receives every value passed to
+ * Stream_Stats_Update(); Stream_Stats_Report() prints its percentiles.
+ *
+ * @param[in,out] stats Running statistics
+ * @param[out] sketch Sketch to attach, owned by the caller
+ *
+ * @return void
+ */
+void Stream_Stats_Attach(Stream_Statistics* stats, Quantile_Sketch* sketch) {
+    Quantile_Sketch_Init(sketch, RNG_DEFAULT_SEED);
+    stats->sketch = sketch;
+}
+
+/**
+ * @brief Adds one value to the running statistics
+ *
+ * Welford's update: the mean moves by delta / count and m2 grows by
+ * delta * (value - new mean), which stays accurate over very long
+ * streams without storing any values.
+ *
+ * @param[in,out] stats Running statistics
+ * @param[in] value Value to add
+ *
+ * @return void
+ */
+void Stream_Stats_Update(Stream_Statistics* stats, int value) {
+    double delta = value - stats->mean; /**< Distance from the old mean */
+
+    stats->count++;
+    stats->sum += value;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * (value - stats->mean);
+    if (value < stats->min) {
+        stats->min = value;
+    }
+    if (value > stats->max) {
+        stats->max = value;
+    }
+    if (stats->sketch != NULL) {
+        Quantile_Sketch_Update(stats->sketch, value);
+    }
+}
+
+/**
+ * @brief Combines the statistics of two disjoint streams
+ *
+ * Chan's pairwise update: the means are weighted by their counts and the
+ * m2 sums are added with a correction for the distance between the means.
+ * If both sides carry a sketch, from's sketch is merged into into's.
+ *
+ * @param[in,out] into Statistics of the first stream, replaced by the combined statistics
+ * @param[in] from Statistics of the second stream
+ *
+ * @return void
+ */
+void Stream_Stats_Merge(Stream_Statistics* into, const Stream_Statistics* from) {
+    if (into->sketch != NULL && from->sketch != NULL) {
+        Quantile_Sketch_Merge(into->sketch, from->sketch);
+    }
+    if (from->count == 0) {
+        return;
+    }
+
+    double count_a = (double)into->count;
+    double count_b = (double)from->count;
+    double count = count_a + count_b;
+    double delta = from->mean - into->mean; /**< Distance between the two means */
+
+    into->mean += delta * count_b / count;
+    into->m2 += from->m2 + delta * delta * count_a * count_b / count;
+    into->count += from->count;
+    into->sum += from->sum;
+    if (from->min < into->min) {
+        into->min = from->min;
+    }
+    if (from->max > into->max) {
+        into->max = from->max;
+    }
+}
+
+/**
+ * @brief Adds a block of values to the running statistics
+ *
+ * The block's own count, sum, extremes and m2 are taken in two passes
+ * over the block, which has no division per value and vectorizes, and
+ * the result is merged in with Stream_Stats_Merge(). Gives the same
+ * statistics as calling Stream_Stats_Update() for every value.
+ *
+ * @param[in,out] stats Running statistics
+ * @param[in] values Values to add
+ * @param[in] count Number of values
+ *
+ * @return void
+ */
+void Stream_Stats_Add_Block(Stream_Statistics* stats, const int values[], int count) {
+    Stream_Statistics block;
+    double m2 = 0.0;
+
+    if (count <= 0) {
+        return;
+    }
+    Stream_Stats_Init(&block);
+    for (int i = 0; i < count; i++) {
+        int value = values[i];
+        block.sum += value;
+        block.min = (value < block.min) ? value : block.min;
+        block.max = (value > block.max) ? value : block.max;
+    }
+    block.count = count;
+    block.mean = (double)block.sum / count;
+    for (int i = 0; i < count; i++) {
+        double deviation = values[i] - block.mean;
+        m2 += deviation * deviation;
+    }
+    block.m2 = m2;
+    Stream_Stats_Merge(stats, &block);
+
+    if (stats->sketch != NULL) {
+        for (int i = 0; i < count; i++) {
+            Quantile_Sketch_Update(stats->sketch, values[i]);
+        }
+    }
+}
+
+/**
+ * @brief Returns the population variance of the values seen
+ *
+ * @param[in] stats Running statistics
+ * @return double Variance, 0 if no values were seen
+ */
+double Stream_Stats_Variance(const Stream_Statistics* stats) {
+    if (stats->count == 0) {
+        return 0.0;
+    }
+    return stats->m2 / (double)stats->count;
+}
+
+/**
+ * @brief Prints the final report of a stream
+ *
+ * @param[in] stats Running statistics
+ *
+ * @return void
+ */
+void Stream_Stats_Report(const Stream_Statistics* stats) {
+    double variance = Stream_Stats_Variance(stats);
+
+    if (stats->count == 0) {
+        printf("\n\nThe stream contained no values");
+        return;
+    }
+    printf("\n\nThe stream contained %lld values with a sum of %lld", stats->count, stats->sum);
+    printf("\n\nThe max and min values in the stream are %d, %d ", stats->max, stats->min);
+    printf("\n\nStream has an average value of %.2f, a variance of %.2f and a standard deviation of %.2f",
+        stats->mean, variance, sqrt(variance));
+
+    double tails[4] = { 50.0, 90.0, 99.0, 99.9 }; /**< Percentiles reported for an attached sketch */
+    int values[4];
+    if (stats->sketch != NULL && Quantile_Sketch_Query(stats->sketch, tails, 4, values) == 0) {
+        printf("\n\nApproximate percentiles p50 %d, p90 %d, p99 %d, p99.9 %d", values[0], values[1], values[2], values[3]);
+    }
+}
+
+/**
+ * @brief Reads integers through a bulk parser until input ends
+ *
+ * Malformed tokens are reported with their byte offset and skipped, so
+ * one bad record does not end a long feed. If stop_at_negative is set, a
+ * negative value also ends the stream, matching the convention of
+ * Keyboard_Input(); otherwise negative values are included like any other.
+ *
+ * @param[in,out] parser Parser to read from
+ * @param[in,out] stats Running statistics to update
+ * @param[in] stop_at_negative Non-zero to treat a negative value as end of input
+ * @return long long Number of values added
+ *
+ * @note Uses constant memory regardless of stream length
+ * @see Parser_Next()
+ */
+long long Stream_Input_Parsed(Int_Parser* parser, Stream_Statistics* stats, int stop_at_negative) {
+    long long added = 0;
+    int value;
+    int status;
+
+    while ((status = Parser_Next(parser, &value)) != PARSE_END) {
+        if (status == PARSE_MALFORMED) {
+            fprintf(stderr, "Skipping malformed input at byte %lld\n", parser->error_offset);
+            continue;
+        }
+        if (stop_at_negative && value < 0) {
+            break;
+        }
+        Stream_Stats_Update(stats, value);
+        added++;
+    }
+    return added;
+}
+
+/**
+ * @brief Reads integers from a file descriptor until it ends
+ *
+ * @param[in] fd Open, readable file descriptor; it is left open
+ * @param[in,out] stats Running statistics to update
+ * @param[in] stop_at_negative Non-zero to treat a negative value as end of input
+ * @return long long Number of values added, -1 if the descriptor could not be read
+ *
+ * @see Stream_Input_Parsed()
+ */
+long long Stream_Input_Fd(int fd, Stream_Statistics* stats, int stop_at_negative) {
+    Arena_Mark mark = Arena_Save(Scratch_Arena());
+    char* buffer = Arena_Alloc(Scratch_Arena(), STREAM_BUFFER_SIZE); /**< Block buffer for read() */
+    Int_Parser parser;
+    long long added;
+
+    if (buffer == NULL) {
+        return -1;
+    }
+    Parser_Init(&parser, fd, buffer, STREAM_BUFFER_SIZE);
+    added = Stream_Input_Parsed(&parser, stats, stop_at_negative);
+    Arena_Restore(Scratch_Arena(), mark);
+    return parser.failed ? -1 : added;
+}
@@ -0,0 +1,36 @@
+#ifndef STREAM_OPERATIONS_HEADER_H
+#define STREAM_OPERATIONS_HEADER_H // include guard
+
+#include <stdio.h>
+#include "Parse_Operations_Header.h" // Int_Parser
+#include "Quantile_Operations_Header.h" // Quantile_Sketch
+
+#define STREAM_BUFFER_SIZE (1 << 20) // read() block size used by Stream_Input_Fd()
+
+/**
+ * @brief Running statistics of an unbounded stream of values
+ *
+ * Updated one value at a time with Welford's algorithm, so memory use
+ * is constant however long the stream is.
+ */
+typedef struct Stream_Statistics {
+    long long count; // number of values seen
+    long long sum; // exact sum of values seen
+    int min; // smallest value seen
+    int max; // largest value seen
+    double mean; // running mean
+    double m2; // running sum of squared deviations from the mean
+    Quantile_Sketch* sketch; // optional tail-percentile sketch fed with every value, NULL for none
+} Stream_Statistics;
+
+void Stream_Stats_Init(Stream_Statistics* stats); // resets the running statistics and detaches any sketch
+void Stream_Stats_Attach(Stream_Statistics* stats, Quantile_Sketch* sketch); // empties sketch and feeds it every later value, for percentiles in the report
+void Stream_Stats_Update(Stream_Statistics* stats, int value); // adds one value (Welford update)
+void Stream_Stats_Add_Block(Stream_Statistics* stats, const int values[], int count); // adds a block of values, scanning it as a whole instead of value by value
+void Stream_Stats_Merge(Stream_Statistics* into, const Stream_Statistics* from); // combines the statistics of two disjoint streams, merging the sketches if both have one
+double Stream_Stats_Variance(const Stream_Statistics* stats); // population variance of the values seen
+void Stream_Stats_Report(const Stream_Statistics* stats); // prints the final report
+long long Stream_Input_Parsed(Int_Parser* parser, Stream_Statistics* stats, int stop_at_negative); // reads values through the bulk parser until end of input, returns how many were added
+long long Stream_Input_Fd(int fd, Stream_Statistics* stats, int stop_at_negative); // same as Stream_Input_Parsed() for a file descriptor
+
+#endif // STREAM_OPERATIONS_HEADER_H